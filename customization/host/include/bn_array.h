@@ -0,0 +1,13 @@
+#ifndef BN_ARRAY_H
+#define BN_ARRAY_H
+
+#include <array>
+
+// Host stand-in for bn::array
+namespace bn
+{
+    template<typename Type, int Size>
+    using array = std::array<Type, Size>;
+}
+
+#endif // BN_ARRAY_H
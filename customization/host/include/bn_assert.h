@@ -0,0 +1,30 @@
+#ifndef BN_ASSERT_H
+#define BN_ASSERT_H
+
+#include <cstdlib>
+#include <iostream>
+
+#include "bn_common.h"
+
+// Host stand-in: failed asserts print their message with the location and
+// abort, so they show up in debuggers and test runners
+#define BN_ERROR(...) \
+    do \
+    { \
+        std::cerr << __FILE__ << ':' << __LINE__ << ": error: "; \
+        [](const auto&... args) { ((std::cerr << args), ...); std::cerr << '\n'; }(__VA_ARGS__); \
+        std::abort(); \
+    } while(false)
+
+#define BN_ASSERT(condition, ...) \
+    do \
+    { \
+        if(!(condition)) [[unlikely]] \
+        { \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": assert failed: " #condition " "; \
+            [](const auto&... args) { ((std::cerr << args), ...); std::cerr << '\n'; }(__VA_ARGS__); \
+            std::abort(); \
+        } \
+    } while(false)
+
+#endif // BN_ASSERT_H
@@ -0,0 +1,16 @@
+#ifndef BN_BG_PALETTE_ITEM_H
+#define BN_BG_PALETTE_ITEM_H
+
+#include "bn_bg_palette_ptr.h"
+
+// Host stand-in for bn::bg_palette_item (no colors)
+namespace bn
+{
+    class bg_palette_item
+    {
+    public:
+        [[nodiscard]] bg_palette_ptr create_palette() const { return bg_palette_ptr(); }
+    };
+}
+
+#endif // BN_BG_PALETTE_ITEM_H
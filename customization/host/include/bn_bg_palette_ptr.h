@@ -0,0 +1,14 @@
+#ifndef BN_BG_PALETTE_PTR_H
+#define BN_BG_PALETTE_PTR_H
+
+#include "bn_common.h"
+
+// Host stand-in for bn::bg_palette_ptr (no colors)
+namespace bn
+{
+    class bg_palette_ptr
+    {
+    };
+}
+
+#endif // BN_BG_PALETTE_PTR_H
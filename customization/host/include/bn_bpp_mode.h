@@ -0,0 +1,14 @@
+#ifndef BN_BPP_MODE_H
+#define BN_BPP_MODE_H
+
+// Host stand-in for bn::bpp_mode
+namespace bn
+{
+    enum class bpp_mode
+    {
+        BPP_4,
+        BPP_8
+    };
+}
+
+#endif // BN_BPP_MODE_H
@@ -0,0 +1,42 @@
+#ifndef BN_CAMERA_PTR_H
+#define BN_CAMERA_PTR_H
+
+#include <memory>
+
+#include "bn_fixed_point.h"
+
+// Host stand-in for bn::camera_ptr: a shared position, like the butano handle
+namespace bn
+{
+    class camera_ptr
+    {
+    public:
+        [[nodiscard]] static camera_ptr create(fixed x, fixed y)
+        {
+            return camera_ptr(fixed_point(x, y));
+        }
+
+        [[nodiscard]] static camera_ptr create(const fixed_point& position)
+        {
+            return camera_ptr(position);
+        }
+
+        [[nodiscard]] fixed x() const { return _position->x(); }
+        [[nodiscard]] fixed y() const { return _position->y(); }
+        [[nodiscard]] const fixed_point& position() const { return *_position; }
+
+        void set_x(fixed x) { _position->set_x(x); }
+        void set_y(fixed y) { _position->set_y(y); }
+        void set_position(fixed x, fixed y) { *_position = fixed_point(x, y); }
+        void set_position(const fixed_point& position) { *_position = position; }
+
+        [[nodiscard]] friend bool operator==(const camera_ptr& a, const camera_ptr& b) = default;
+
+    private:
+        std::shared_ptr<fixed_point> _position;
+
+        explicit camera_ptr(const fixed_point& position) : _position(std::make_shared<fixed_point>(position)) {}
+    };
+}
+
+#endif // BN_CAMERA_PTR_H
@@ -0,0 +1,27 @@
+#ifndef BN_COLOR_H
+#define BN_COLOR_H
+
+#include "bn_common.h"
+
+// Host stand-in for bn::color (5 bits per channel)
+namespace bn
+{
+    class color
+    {
+    public:
+        constexpr color() = default;
+        constexpr color(int red, int green, int blue) : _data(uint16_t(red | (green << 5) | (blue << 10))) {}
+
+        [[nodiscard]] constexpr int red() const { return _data & 31; }
+        [[nodiscard]] constexpr int green() const { return (_data >> 5) & 31; }
+        [[nodiscard]] constexpr int blue() const { return (_data >> 10) & 31; }
+        [[nodiscard]] constexpr int data() const { return _data; }
+
+        [[nodiscard]] constexpr friend bool operator==(color a, color b) = default;
+
+    private:
+        uint16_t _data = 0;
+    };
+}
+
+#endif // BN_COLOR_H
@@ -0,0 +1,22 @@
+#ifndef BN_COMMON_H
+#define BN_COMMON_H
+
+// -----------------------------------------------------------------------------
+// Host stand-in for butano's bn_common.h
+// -----------------------------------------------------------------------------
+// The host build (see host/Makefile) compiles the game logic for Linux against
+// these headers instead of butano. They only cover what the game uses, with
+// the same names and arithmetic, and no hardware behind them.
+// -----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+
+// No IWRAM on the host: everything is ordinary code and data
+#define BN_CODE_IWRAM
+#define BN_DATA_EWRAM
+#define BN_DATA_EWRAM_BSS
+
+#define BN_UNREACHABLE() __builtin_unreachable()
+
+#endif // BN_COMMON_H
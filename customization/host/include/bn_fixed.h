@@ -0,0 +1,91 @@
+#ifndef BN_FIXED_H
+#define BN_FIXED_H
+
+#include <ostream>
+
+#include "bn_assert.h"
+
+// Host stand-in for bn::fixed: 20.12 fixed point with butano's rounding, so
+// the host simulation gives the same results as the ROM
+namespace bn
+{
+    class fixed
+    {
+    public:
+        [[nodiscard]] static constexpr int precision() { return 12; }
+        [[nodiscard]] static constexpr int scale() { return 1 << precision(); }
+
+        [[nodiscard]] static constexpr fixed from_data(int data)
+        {
+            fixed result;
+            result._data = data;
+            return result;
+        }
+
+        constexpr fixed() = default;
+        constexpr fixed(int value) : _data(value * scale()) {}
+        constexpr fixed(float value) : _data(int(value * scale())) {}
+        constexpr fixed(double value) : _data(int(value * scale())) {}
+
+        [[nodiscard]] constexpr int data() const { return _data; }
+
+        [[nodiscard]] constexpr int integer() const { return _data / scale(); }
+        [[nodiscard]] constexpr int floor_integer() const { return _data >> precision(); }
+        [[nodiscard]] constexpr int round_integer() const { return (_data + scale() / 2) >> precision(); }
+        [[nodiscard]] constexpr int ceil_integer() const { return (_data + scale() - 1) >> precision(); }
+        [[nodiscard]] constexpr int right_shift_integer() const { return _data >> precision(); }
+
+        [[nodiscard]] constexpr float to_float() const { return float(_data) / scale(); }
+        [[nodiscard]] constexpr double to_double() const { return double(_data) / scale(); }
+
+        [[nodiscard]] constexpr fixed fraction() const { return from_data(_data & (scale() - 1)); }
+
+        [[nodiscard]] constexpr fixed operator-() const { return from_data(-_data); }
+
+        constexpr fixed& operator+=(fixed other) { _data += other._data; return *this; }
+        constexpr fixed& operator-=(fixed other) { _data -= other._data; return *this; }
+
+        constexpr fixed& operator*=(fixed other)
+        {
+            _data = int((int64_t(_data) * other._data) >> precision());
+            return *this;
+        }
+
+        constexpr fixed& operator*=(int value) { _data *= value; return *this; }
+
+        constexpr fixed& operator/=(fixed other)
+        {
+            BN_ASSERT(other._data, "Invalid value: ", other._data);
+            _data = int((int64_t(_data) * scale()) / other._data);
+            return *this;
+        }
+
+        constexpr fixed& operator/=(int value)
+        {
+            BN_ASSERT(value, "Invalid value: ", value);
+            _data /= value;
+            return *this;
+        }
+
+        [[nodiscard]] constexpr friend fixed operator+(fixed a, fixed b) { return a += b; }
+        [[nodiscard]] constexpr friend fixed operator-(fixed a, fixed b) { return a -= b; }
+        [[nodiscard]] constexpr friend fixed operator*(fixed a, fixed b) { return a *= b; }
+        [[nodiscard]] constexpr friend fixed operator*(fixed a, int b) { return a *= b; }
+        [[nodiscard]] constexpr friend fixed operator*(int a, fixed b) { return b *= a; }
+        [[nodiscard]] constexpr friend fixed operator/(fixed a, fixed b) { return a /= b; }
+        [[nodiscard]] constexpr friend fixed operator/(fixed a, int b) { return a /= b; }
+
+        [[nodiscard]] constexpr friend bool operator==(fixed a, fixed b) = default;
+        [[nodiscard]] constexpr friend auto operator<=>(fixed a, fixed b) { return a._data <=> b._data; }
+
+        friend std::ostream& operator<<(std::ostream& stream, fixed value)
+        {
+            return stream << value.to_double();
+        }
+
+    private:
+        int _data = 0;
+    };
+}
+
+#endif // BN_FIXED_H
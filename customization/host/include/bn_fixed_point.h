@@ -0,0 +1,52 @@
+#ifndef BN_FIXED_POINT_H
+#define BN_FIXED_POINT_H
+
+#include "bn_fixed.h"
+#include "bn_point.h"
+
+// Host stand-in for bn::fixed_point
+namespace bn
+{
+    class fixed_point
+    {
+    public:
+        constexpr fixed_point() = default;
+        constexpr fixed_point(fixed x, fixed y) : _x(x), _y(y) {}
+        constexpr fixed_point(const point& value) : _x(value.x()), _y(value.y()) {}
+
+        [[nodiscard]] constexpr fixed x() const { return _x; }
+        [[nodiscard]] constexpr fixed y() const { return _y; }
+        constexpr void set_x(fixed x) { _x = x; }
+        constexpr void set_y(fixed y) { _y = y; }
+        constexpr void set_xy(fixed x, fixed y) { _x = x; _y = y; }
+
+        [[nodiscard]] constexpr fixed_point operator-() const { return fixed_point(-_x, -_y); }
+
+        constexpr fixed_point& operator+=(const fixed_point& other) { _x += other._x; _y += other._y; return *this; }
+        constexpr fixed_point& operator-=(const fixed_point& other) { _x -= other._x; _y -= other._y; return *this; }
+        constexpr fixed_point& operator*=(fixed value) { _x *= value; _y *= value; return *this; }
+        constexpr fixed_point& operator*=(int value) { _x *= value; _y *= value; return *this; }
+        constexpr fixed_point& operator/=(fixed value) { _x /= value; _y /= value; return *this; }
+        constexpr fixed_point& operator/=(int value) { _x /= value; _y /= value; return *this; }
+
+        [[nodiscard]] constexpr friend fixed_point operator+(fixed_point a, const fixed_point& b) { return a += b; }
+        [[nodiscard]] constexpr friend fixed_point operator-(fixed_point a, const fixed_point& b) { return a -= b; }
+        [[nodiscard]] constexpr friend fixed_point operator*(fixed_point a, fixed b) { return a *= b; }
+        [[nodiscard]] constexpr friend fixed_point operator*(fixed_point a, int b) { return a *= b; }
+        [[nodiscard]] constexpr friend fixed_point operator/(fixed_point a, fixed b) { return a /= b; }
+        [[nodiscard]] constexpr friend fixed_point operator/(fixed_point a, int b) { return a /= b; }
+
+        [[nodiscard]] constexpr friend bool operator==(const fixed_point& a, const fixed_point& b) = default;
+
+        friend std::ostream& operator<<(std::ostream& stream, const fixed_point& value)
+        {
+            return stream << '(' << value._x << ", " << value._y << ')';
+        }
+
+    private:
+        fixed _x;
+        fixed _y;
+    };
+}
+
+#endif // BN_FIXED_POINT_H
@@ -0,0 +1,48 @@
+#ifndef BN_FIXED_RECT_H
+#define BN_FIXED_RECT_H
+
+#include "bn_fixed_point.h"
+
+// Host stand-in for bn::fixed_rect (center position and dimensions)
+namespace bn
+{
+    class fixed_rect
+    {
+    public:
+        constexpr fixed_rect() = default;
+
+        constexpr fixed_rect(fixed x, fixed y, fixed width, fixed height) :
+            _position(x, y), _width(width), _height(height)
+        {
+        }
+
+        [[nodiscard]] constexpr const fixed_point& position() const { return _position; }
+        [[nodiscard]] constexpr fixed x() const { return _position.x(); }
+        [[nodiscard]] constexpr fixed y() const { return _position.y(); }
+        [[nodiscard]] constexpr fixed width() const { return _width; }
+        [[nodiscard]] constexpr fixed height() const { return _height; }
+
+        [[nodiscard]] constexpr fixed left() const { return x() - _width / 2; }
+        [[nodiscard]] constexpr fixed right() const { return left() + _width; }
+        [[nodiscard]] constexpr fixed top() const { return y() - _height / 2; }
+        [[nodiscard]] constexpr fixed bottom() const { return top() + _height; }
+
+        [[nodiscard]] constexpr bool contains(const fixed_point& point) const
+        {
+            return point.x() >= left() && point.x() <= right() && point.y() >= top() && point.y() <= bottom();
+        }
+
+        [[nodiscard]] constexpr bool intersects(const fixed_rect& other) const
+        {
+            return left() < other.right() && right() > other.left() &&
+                   top() < other.bottom() && bottom() > other.top();
+        }
+
+    private:
+        fixed_point _position;
+        fixed _width;
+        fixed _height;
+    };
+}
+
+#endif // BN_FIXED_RECT_H
@@ -0,0 +1,35 @@
+#ifndef BN_KEYPAD_H
+#define BN_KEYPAD_H
+
+#include "bn_common.h"
+
+// Host stand-in for bn::keypad: the held keys are set by the host program
+// (host::set_keypad) instead of read from the hardware
+namespace bn::keypad
+{
+    enum class key_type
+    {
+        A      = 0x0001,
+        B      = 0x0002,
+        SELECT = 0x0004,
+        START  = 0x0008,
+        RIGHT  = 0x0010,
+        LEFT   = 0x0020,
+        UP     = 0x0040,
+        DOWN   = 0x0080,
+        R      = 0x0100,
+        L      = 0x0200
+    };
+
+    [[nodiscard]] bool held(key_type key);
+    [[nodiscard]] bool pressed(key_type key);
+    [[nodiscard]] bool released(key_type key);
+}
+
+namespace host
+{
+    // Keys held from the next frame on (key_type flags)
+    void set_keypad(int keys);
+}
+
+#endif // BN_KEYPAD_H
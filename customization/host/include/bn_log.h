@@ -0,0 +1,25 @@
+#ifndef BN_LOG_H
+#define BN_LOG_H
+
+#include <iostream>
+
+#include "bn_common.h"
+
+// Host stand-in: BN_LOG prints its arguments to stderr, unless logging was
+// turned off with host::set_logging(false)
+namespace host
+{
+    bool logging();
+    void set_logging(bool enabled);
+}
+
+#define BN_LOG(...) \
+    do \
+    { \
+        if(host::logging()) \
+        { \
+            [](const auto&... args) { ((std::cerr << args), ...); std::cerr << '\n'; }(__VA_ARGS__); \
+        } \
+    } while(false)
+
+#endif // BN_LOG_H
@@ -0,0 +1,42 @@
+#ifndef BN_MATH_H
+#define BN_MATH_H
+
+#include <cmath>
+
+#include "bn_fixed.h"
+#include "bn_utility.h"
+
+// Host stand-in for bn_math.h (only what the game logic uses)
+namespace bn
+{
+    template<typename Type>
+    [[nodiscard]] constexpr Type abs(const Type& value)
+    {
+        return value < 0 ? -value : value;
+    }
+
+    template<typename Type>
+    [[nodiscard]] constexpr const Type& min(const Type& a, const Type& b)
+    {
+        return b < a ? b : a;
+    }
+
+    template<typename Type>
+    [[nodiscard]] constexpr const Type& max(const Type& a, const Type& b)
+    {
+        return a < b ? b : a;
+    }
+
+    template<typename Type>
+    [[nodiscard]] constexpr const Type& clamp(const Type& value, const Type& low, const Type& high)
+    {
+        return value < low ? low : (high < value ? high : value);
+    }
+
+    [[nodiscard]] inline fixed sqrt(fixed value)
+    {
+        return fixed::from_data(int(std::sqrt(double(value.data()) * fixed::scale())));
+    }
+}
+
+#endif // BN_MATH_H
@@ -0,0 +1,18 @@
+#ifndef BN_MEMORY_H
+#define BN_MEMORY_H
+
+#include <cstring>
+
+#include "bn_common.h"
+
+// Host stand-in for bn::memory
+namespace bn::memory
+{
+    template<typename Type>
+    void copy(const Type& source_ref, int elements, Type& destination_ref)
+    {
+        std::memmove(&destination_ref, &source_ref, size_t(elements) * sizeof(Type));
+    }
+}
+
+#endif // BN_MEMORY_H
@@ -0,0 +1,17 @@
+#ifndef BN_OPTIONAL_H
+#define BN_OPTIONAL_H
+
+#include <optional>
+
+#include "bn_common.h"
+
+// Host stand-in for bn::optional
+namespace bn
+{
+    template<typename Type>
+    using optional = std::optional<Type>;
+
+    using std::nullopt;
+}
+
+#endif // BN_OPTIONAL_H
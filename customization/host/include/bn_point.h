@@ -0,0 +1,47 @@
+#ifndef BN_POINT_H
+#define BN_POINT_H
+
+#include <ostream>
+
+#include "bn_common.h"
+
+// Host stand-in for bn::point
+namespace bn
+{
+    class point
+    {
+    public:
+        constexpr point() = default;
+        constexpr point(int x, int y) : _x(x), _y(y) {}
+
+        [[nodiscard]] constexpr int x() const { return _x; }
+        [[nodiscard]] constexpr int y() const { return _y; }
+        constexpr void set_x(int x) { _x = x; }
+        constexpr void set_y(int y) { _y = y; }
+
+        [[nodiscard]] constexpr point operator-() const { return point(-_x, -_y); }
+
+        constexpr point& operator+=(const point& other) { _x += other._x; _y += other._y; return *this; }
+        constexpr point& operator-=(const point& other) { _x -= other._x; _y -= other._y; return *this; }
+        constexpr point& operator*=(int value) { _x *= value; _y *= value; return *this; }
+        constexpr point& operator/=(int value) { _x /= value; _y /= value; return *this; }
+
+        [[nodiscard]] constexpr friend point operator+(point a, const point& b) { return a += b; }
+        [[nodiscard]] constexpr friend point operator-(point a, const point& b) { return a -= b; }
+        [[nodiscard]] constexpr friend point operator*(point a, int b) { return a *= b; }
+        [[nodiscard]] constexpr friend point operator/(point a, int b) { return a /= b; }
+
+        [[nodiscard]] constexpr friend bool operator==(const point& a, const point& b) = default;
+
+        friend std::ostream& operator<<(std::ostream& stream, const point& value)
+        {
+            return stream << '(' << value._x << ", " << value._y << ')';
+        }
+
+    private:
+        int _x = 0;
+        int _y = 0;
+    };
+}
+
+#endif // BN_POINT_H
@@ -0,0 +1,12 @@
+#ifndef BN_REGULAR_BG_MAP_CELL_H
+#define BN_REGULAR_BG_MAP_CELL_H
+
+#include "bn_common.h"
+
+// Host stand-in for bn::regular_bg_map_cell
+namespace bn
+{
+    using regular_bg_map_cell = uint16_t;
+}
+
+#endif // BN_REGULAR_BG_MAP_CELL_H
@@ -0,0 +1,51 @@
+#ifndef BN_REGULAR_BG_MAP_PTR_H
+#define BN_REGULAR_BG_MAP_PTR_H
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "bn_optional.h"
+#include "bn_size.h"
+#include "bn_regular_bg_map_cell.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_bg_palette_ptr.h"
+
+// Host stand-in for bn::regular_bg_map_ptr: the "VRAM" cells are a shared
+// buffer in RAM, so map writes cost what they would cost without the bus
+namespace bn
+{
+    class regular_bg_map_ptr
+    {
+    public:
+        [[nodiscard]] static regular_bg_map_ptr allocate(const size& dimensions, const regular_bg_tiles_ptr&,
+                                                         const bg_palette_ptr&)
+        {
+            return regular_bg_map_ptr(dimensions);
+        }
+
+        [[nodiscard]] const size& dimensions() const { return _dimensions; }
+
+        [[nodiscard]] optional<std::span<regular_bg_map_cell>> vram()
+        {
+            return std::span<regular_bg_map_cell>(*_cells);
+        }
+
+        [[nodiscard]] friend bool operator==(const regular_bg_map_ptr& a, const regular_bg_map_ptr& b)
+        {
+            return a._cells == b._cells;
+        }
+
+    private:
+        size _dimensions;
+        std::shared_ptr<std::vector<regular_bg_map_cell>> _cells;
+
+        explicit regular_bg_map_ptr(const size& dimensions) :
+            _dimensions(dimensions),
+            _cells(std::make_shared<std::vector<regular_bg_map_cell>>(dimensions.width() * dimensions.height()))
+        {
+        }
+    };
+}
+
+#endif // BN_REGULAR_BG_MAP_PTR_H
@@ -0,0 +1,44 @@
+#ifndef BN_REGULAR_BG_PTR_H
+#define BN_REGULAR_BG_PTR_H
+
+#include "bn_camera_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+
+// Host stand-in for bn::regular_bg_ptr (attributes only, nothing is drawn)
+namespace bn
+{
+    class regular_bg_ptr
+    {
+    public:
+        [[nodiscard]] static regular_bg_ptr create(fixed x, fixed y, const regular_bg_map_ptr& map)
+        {
+            return regular_bg_ptr(fixed_point(x, y), map);
+        }
+
+        [[nodiscard]] const fixed_point& position() const { return _position; }
+        void set_position(const fixed_point& position) { _position = position; }
+        void set_position(fixed x, fixed y) { _position = fixed_point(x, y); }
+
+        [[nodiscard]] int priority() const { return _priority; }
+        void set_priority(int priority) { _priority = priority; }
+
+        [[nodiscard]] const optional<camera_ptr>& camera() const { return _camera; }
+        void set_camera(const camera_ptr& camera) { _camera = camera; }
+        void remove_camera() { _camera.reset(); }
+
+        [[nodiscard]] const regular_bg_map_ptr& map() const { return _map; }
+
+    private:
+        fixed_point _position;
+        regular_bg_map_ptr _map;
+        int _priority = 3;
+        optional<camera_ptr> _camera;
+
+        regular_bg_ptr(const fixed_point& position, const regular_bg_map_ptr& map) :
+            _position(position), _map(map)
+        {
+        }
+    };
+}
+
+#endif // BN_REGULAR_BG_PTR_H
@@ -0,0 +1,16 @@
+#ifndef BN_REGULAR_BG_TILES_ITEM_H
+#define BN_REGULAR_BG_TILES_ITEM_H
+
+#include "bn_regular_bg_tiles_ptr.h"
+
+// Host stand-in for bn::regular_bg_tiles_item (no tiles)
+namespace bn
+{
+    class regular_bg_tiles_item
+    {
+    public:
+        [[nodiscard]] regular_bg_tiles_ptr create_tiles() const { return regular_bg_tiles_ptr(); }
+    };
+}
+
+#endif // BN_REGULAR_BG_TILES_ITEM_H
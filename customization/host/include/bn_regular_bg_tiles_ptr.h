@@ -0,0 +1,14 @@
+#ifndef BN_REGULAR_BG_TILES_PTR_H
+#define BN_REGULAR_BG_TILES_PTR_H
+
+#include "bn_common.h"
+
+// Host stand-in for bn::regular_bg_tiles_ptr (no tiles)
+namespace bn
+{
+    class regular_bg_tiles_ptr
+    {
+    };
+}
+
+#endif // BN_REGULAR_BG_TILES_PTR_H
@@ -0,0 +1,24 @@
+#ifndef BN_SIZE_H
+#define BN_SIZE_H
+
+#include "bn_common.h"
+
+// Host stand-in for bn::size
+namespace bn
+{
+    class size
+    {
+    public:
+        constexpr size() = default;
+        constexpr size(int width, int height) : _width(width), _height(height) {}
+
+        [[nodiscard]] constexpr int width() const { return _width; }
+        [[nodiscard]] constexpr int height() const { return _height; }
+
+    private:
+        int _width = 0;
+        int _height = 0;
+    };
+}
+
+#endif // BN_SIZE_H
@@ -0,0 +1,13 @@
+#ifndef BN_SPAN_H
+#define BN_SPAN_H
+
+#include <span>
+
+// Host stand-in for bn::span
+namespace bn
+{
+    template<typename Type>
+    using span = std::span<Type>;
+}
+
+#endif // BN_SPAN_H
@@ -0,0 +1,42 @@
+#ifndef BN_SPRITE_ITEM_H
+#define BN_SPRITE_ITEM_H
+
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_palette_item.h"
+#include "bn_sprite_shape_size.h"
+
+// Host stand-in for bn::sprite_item. Items are generated from the graphics
+// folder by host/tools/item_stubs.py, with the frame size, the color depth
+// and no pixels.
+namespace bn
+{
+    class sprite_item
+    {
+    public:
+        constexpr sprite_item(int width, int height, bpp_mode bpp) : _tiles_item(width, height, bpp) {}
+
+        [[nodiscard]] constexpr const sprite_tiles_item& tiles_item() const { return _tiles_item; }
+
+        [[nodiscard]] constexpr sprite_shape_size shape_size() const
+        {
+            return sprite_shape_size(_tiles_item.width(), _tiles_item.height());
+        }
+        [[nodiscard]] constexpr const sprite_palette_item& palette_item() const { return _palette_item; }
+
+        [[nodiscard]] sprite_ptr create_sprite(fixed x, fixed y, int graphics_index = 0) const
+        {
+            return sprite_ptr(x, y, _tiles_item, graphics_index);
+        }
+
+        [[nodiscard]] sprite_ptr create_sprite(const fixed_point& position, int graphics_index = 0) const
+        {
+            return sprite_ptr(position.x(), position.y(), _tiles_item, graphics_index);
+        }
+
+    private:
+        sprite_tiles_item _tiles_item;
+        sprite_palette_item _palette_item;
+    };
+}
+
+#endif // BN_SPRITE_ITEM_H
@@ -0,0 +1,19 @@
+#ifndef BN_SPRITE_PALETTE_ITEM_H
+#define BN_SPRITE_PALETTE_ITEM_H
+
+#include "bn_sprite_palette_ptr.h"
+
+// Host stand-in for bn::sprite_palette_item (no color data)
+namespace bn
+{
+    class sprite_palette_item
+    {
+    public:
+        constexpr sprite_palette_item() = default;
+
+        [[nodiscard]] sprite_palette_ptr create_palette() const { return sprite_palette_ptr(); }
+        [[nodiscard]] sprite_palette_ptr create_new_palette() const { return sprite_palette_ptr(); }
+    };
+}
+
+#endif // BN_SPRITE_PALETTE_ITEM_H
@@ -0,0 +1,27 @@
+#ifndef BN_SPRITE_PALETTE_PTR_H
+#define BN_SPRITE_PALETTE_PTR_H
+
+#include <array>
+#include <memory>
+
+#include "bn_color.h"
+
+// Host stand-in for bn::sprite_palette_ptr: shared colors, like the butano handle
+namespace bn
+{
+    class sprite_palette_ptr
+    {
+    public:
+        sprite_palette_ptr() : _colors(std::make_shared<std::array<color, 256>>()) {}
+
+        [[nodiscard]] color get_color(int index) const { return (*_colors)[index]; }
+        void set_color(int index, color value) { (*_colors)[index] = value; }
+
+        [[nodiscard]] friend bool operator==(const sprite_palette_ptr& a, const sprite_palette_ptr& b) = default;
+
+    private:
+        std::shared_ptr<std::array<color, 256>> _colors;
+    };
+}
+
+#endif // BN_SPRITE_PALETTE_PTR_H
@@ -0,0 +1,122 @@
+#ifndef BN_SPRITE_PTR_H
+#define BN_SPRITE_PTR_H
+
+#include <memory>
+
+#include "bn_camera_ptr.h"
+#include "bn_optional.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_shape_size.h"
+#include "bn_sprite_tiles_item.h"
+#include "bn_sprite_tiles_ptr.h"
+
+// Host stand-in for bn::sprite_ptr: a shared record of the sprite attributes,
+// like the butano handle. Nothing is drawn; live_count() tells how many
+// hardware sprites the game would be using.
+namespace bn
+{
+    class sprite_ptr
+    {
+    public:
+        sprite_ptr(fixed x, fixed y, const sprite_tiles_item& tiles_item, int graphics_index) :
+            sprite_ptr(new state(fixed_point(x, y), tiles_item, graphics_index))
+        {
+        }
+
+        [[nodiscard]] static sprite_ptr create(const fixed_point& position, const sprite_shape_size& shape_size,
+                                               const sprite_tiles_ptr& tiles, const sprite_palette_ptr& palette)
+        {
+            sprite_ptr result(new state(position, sprite_tiles_item(shape_size.width(), shape_size.height(),
+                                                                    tiles.bpp()), 0));
+            result._state->tiles = tiles;
+            result._state->palette = palette;
+            return result;
+        }
+
+        [[nodiscard]] static int live_count() { return _live_count; }
+
+        [[nodiscard]] fixed x() const { return _state->position.x(); }
+        [[nodiscard]] fixed y() const { return _state->position.y(); }
+        [[nodiscard]] const fixed_point& position() const { return _state->position; }
+
+        void set_x(fixed x) { _state->position.set_x(x); }
+        void set_y(fixed y) { _state->position.set_y(y); }
+        void set_position(fixed x, fixed y) { _state->position = fixed_point(x, y); }
+        void set_position(const fixed_point& position) { _state->position = position; }
+
+        [[nodiscard]] int z_order() const { return _state->z_order; }
+        void set_z_order(int z_order) { _state->z_order = z_order; }
+
+        [[nodiscard]] int bg_priority() const { return _state->bg_priority; }
+        void set_bg_priority(int bg_priority) { _state->bg_priority = bg_priority; }
+
+        [[nodiscard]] bool visible() const { return _state->visible; }
+        void set_visible(bool visible) { _state->visible = visible; }
+
+        [[nodiscard]] bool horizontal_flip() const { return _state->horizontal_flip; }
+        void set_horizontal_flip(bool horizontal_flip) { _state->horizontal_flip = horizontal_flip; }
+
+        [[nodiscard]] fixed scale() const { return _state->scale; }
+        void set_scale(fixed scale) { _state->scale = scale; }
+
+        [[nodiscard]] const optional<camera_ptr>& camera() const { return _state->camera; }
+        void set_camera(const camera_ptr& camera) { _state->camera = camera; }
+        void remove_camera() { _state->camera.reset(); }
+
+        [[nodiscard]] int graphics_index() const { return _state->graphics_index; }
+
+        void set_tiles(const sprite_tiles_item& tiles_item, int graphics_index)
+        {
+            _state->tiles_item = tiles_item;
+            _state->graphics_index = graphics_index;
+            _state->tiles.reset();
+        }
+
+        // Tiles allocated by the game (sprites created from a sprite_tiles_ptr)
+        [[nodiscard]] const optional<sprite_tiles_ptr>& tiles() const { return _state->tiles; }
+        void set_tiles(const sprite_tiles_ptr& tiles) { _state->tiles = tiles; }
+
+        // Palette set by the game (otherwise the one of the sprite item)
+        [[nodiscard]] const optional<sprite_palette_ptr>& palette() const { return _state->palette; }
+        void set_palette(const sprite_palette_ptr& palette) { _state->palette = palette; }
+
+        [[nodiscard]] friend bool operator==(const sprite_ptr& a, const sprite_ptr& b) = default;
+
+    private:
+        struct state
+        {
+            state(const fixed_point& position_, const sprite_tiles_item& tiles_item_, int graphics_index_) :
+                position(position_), tiles_item(tiles_item_), graphics_index(graphics_index_)
+            {
+            }
+
+            fixed_point position;
+            sprite_tiles_item tiles_item;
+            int graphics_index;
+            optional<sprite_tiles_ptr> tiles;
+            optional<sprite_palette_ptr> palette;
+            int z_order = 0;
+            int bg_priority = 3;
+            bool visible = true;
+            bool horizontal_flip = false;
+            fixed scale = 1;
+            optional<camera_ptr> camera;
+        };
+
+        std::shared_ptr<state> _state;
+
+        explicit sprite_ptr(state* value) :
+            _state(value, [](state* released)
+            {
+                --_live_count;
+                delete released;
+            })
+        {
+            ++_live_count;
+        }
+
+        inline static int _live_count = 0;
+    };
+}
+
+#endif // BN_SPRITE_PTR_H
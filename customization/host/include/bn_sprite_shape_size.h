@@ -0,0 +1,23 @@
+#ifndef BN_SPRITE_SHAPE_SIZE_H
+#define BN_SPRITE_SHAPE_SIZE_H
+
+// Host stand-in for bn::sprite_shape_size (width and height in pixels)
+namespace bn
+{
+    class sprite_shape_size
+    {
+    public:
+        constexpr sprite_shape_size(int width, int height) : _width(width), _height(height) {}
+
+        [[nodiscard]] constexpr int width() const { return _width; }
+        [[nodiscard]] constexpr int height() const { return _height; }
+
+        [[nodiscard]] constexpr friend bool operator==(const sprite_shape_size& a, const sprite_shape_size& b) = default;
+
+    private:
+        int _width;
+        int _height;
+    };
+}
+
+#endif // BN_SPRITE_SHAPE_SIZE_H
@@ -0,0 +1,24 @@
+#ifndef BN_SPRITE_TEXT_GENERATOR_H
+#define BN_SPRITE_TEXT_GENERATOR_H
+
+#include "bn_sprite_ptr.h"
+#include "bn_vector.h"
+
+// Host stand-in for bn::sprite_text_generator: generates no sprites
+namespace bn
+{
+    class sprite_text_generator
+    {
+    public:
+        void set_left_alignment() {}
+        void set_center_alignment() {}
+        void set_right_alignment() {}
+
+        template<int MaxSprites, typename Text>
+        void generate(fixed, fixed, const Text&, vector<sprite_ptr, MaxSprites>&) const
+        {
+        }
+    };
+}
+
+#endif // BN_SPRITE_TEXT_GENERATOR_H
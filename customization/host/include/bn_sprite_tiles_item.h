@@ -0,0 +1,48 @@
+#ifndef BN_SPRITE_TILES_ITEM_H
+#define BN_SPRITE_TILES_ITEM_H
+
+#include "bn_assert.h"
+#include "bn_bpp_mode.h"
+#include "bn_common.h"
+#include "bn_span.h"
+#include "bn_tile.h"
+
+// Host stand-in for bn::sprite_tiles_item: the frame size and color depth.
+// There is no tile data: every frame reads as transparent tiles.
+namespace bn
+{
+    class sprite_tiles_item
+    {
+    public:
+        constexpr sprite_tiles_item(int width, int height, bpp_mode bpp) :
+            _width(width), _height(height), _bpp(bpp)
+        {
+        }
+
+        [[nodiscard]] constexpr int width() const { return _width; }
+        [[nodiscard]] constexpr int height() const { return _height; }
+        [[nodiscard]] constexpr bpp_mode bpp() const { return _bpp; }
+
+        [[nodiscard]] constexpr int tiles_count_per_graphic() const
+        {
+            return (_width / 8) * (_height / 8) * (_bpp == bpp_mode::BPP_8 ? 2 : 1);
+        }
+
+        [[nodiscard]] span<const tile> graphics_tiles_ref(int) const
+        {
+            static const tile transparent_tiles[128] = {};
+
+            BN_ASSERT(tiles_count_per_graphic() <= 128, "Sprite frame too big for the host: ", _width, "x", _height);
+            return span<const tile>(transparent_tiles, tiles_count_per_graphic());
+        }
+
+        [[nodiscard]] constexpr friend bool operator==(const sprite_tiles_item& a, const sprite_tiles_item& b) = default;
+
+    private:
+        int _width;
+        int _height;
+        bpp_mode _bpp;
+    };
+}
+
+#endif // BN_SPRITE_TILES_ITEM_H
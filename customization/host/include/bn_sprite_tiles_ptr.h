@@ -0,0 +1,49 @@
+#ifndef BN_SPRITE_TILES_PTR_H
+#define BN_SPRITE_TILES_PTR_H
+
+#include <memory>
+#include <vector>
+
+#include "bn_bpp_mode.h"
+#include "bn_optional.h"
+#include "bn_span.h"
+#include "bn_tile.h"
+
+// Host stand-in for bn::sprite_tiles_ptr: the "VRAM" tiles are a shared
+// buffer in RAM, so tile writes cost what they would cost without the bus
+namespace bn
+{
+    class sprite_tiles_ptr
+    {
+    public:
+        [[nodiscard]] static sprite_tiles_ptr allocate(int tiles_count, bpp_mode bpp)
+        {
+            return sprite_tiles_ptr(tiles_count, bpp);
+        }
+
+        [[nodiscard]] int tiles_count() const { return int(_tiles->size()); }
+        [[nodiscard]] bpp_mode bpp() const { return _bpp; }
+
+        [[nodiscard]] optional<span<tile>> vram()
+        {
+            return span<tile>(*_tiles);
+        }
+
+        [[nodiscard]] friend bool operator==(const sprite_tiles_ptr& a, const sprite_tiles_ptr& b)
+        {
+            return a._tiles == b._tiles;
+        }
+
+    private:
+        std::shared_ptr<std::vector<tile>> _tiles;
+        bpp_mode _bpp;
+
+        sprite_tiles_ptr(int tiles_count, bpp_mode bpp) :
+            _tiles(std::make_shared<std::vector<tile>>(tiles_count)),
+            _bpp(bpp)
+        {
+        }
+    };
+}
+
+#endif // BN_SPRITE_TILES_PTR_H
@@ -0,0 +1,20 @@
+#ifndef BN_SPRITES_H
+#define BN_SPRITES_H
+
+#include "bn_sprite_ptr.h"
+
+// Host stand-in for the sprite counters of butano (128 hardware sprites)
+namespace bn::sprites
+{
+    [[nodiscard]] inline int used_items_count()
+    {
+        return sprite_ptr::live_count();
+    }
+
+    [[nodiscard]] inline int available_items_count()
+    {
+        return 128 - used_items_count();
+    }
+}
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef BN_SRAM_H
+#define BN_SRAM_H
+
+#include <cstring>
+#include <type_traits>
+
+#include "bn_assert.h"
+
+// Host stand-in for bn::sram: 32KB of RAM, kept for the run of the program
+// (host::sram_data() gives access to it, e.g. to load or save a .sav file)
+namespace host
+{
+    constexpr int sram_size = 32 * 1024;
+
+    [[nodiscard]] uint8_t* sram_data();
+}
+
+namespace bn::sram
+{
+    [[nodiscard]] constexpr int size() { return host::sram_size; }
+
+    template<typename Type>
+    void write_offset(const Type& source, int offset)
+    {
+        static_assert(std::is_trivially_copyable_v<Type>);
+        BN_ASSERT(offset >= 0 && offset + int(sizeof(Type)) <= size(), "Invalid offset: ", offset);
+        std::memcpy(host::sram_data() + offset, &source, sizeof(Type));
+    }
+
+    template<typename Type>
+    void read_offset(Type& destination, int offset)
+    {
+        static_assert(std::is_trivially_copyable_v<Type>);
+        BN_ASSERT(offset >= 0 && offset + int(sizeof(Type)) <= size(), "Invalid offset: ", offset);
+        std::memcpy(&destination, host::sram_data() + offset, sizeof(Type));
+    }
+
+    template<typename Type>
+    void write(const Type& source)
+    {
+        write_offset(source, 0);
+    }
+
+    template<typename Type>
+    void read(Type& destination)
+    {
+        read_offset(destination, 0);
+    }
+}
+
+#endif // BN_SRAM_H
@@ -0,0 +1,29 @@
+#ifndef BN_STRING_H
+#define BN_STRING_H
+
+#include <string>
+
+#include "bn_common.h"
+
+// Host stand-in for bn::string and bn::to_string
+namespace bn
+{
+    template<int MaxSize>
+    class string : public std::string
+    {
+    public:
+        using std::string::string;
+        using std::string::operator=;
+        using std::string::operator+=;
+    };
+
+    template<int MaxSize, typename Type>
+    [[nodiscard]] string<MaxSize> to_string(const Type& value)
+    {
+        string<MaxSize> result;
+        result += std::to_string(value);
+        return result;
+    }
+}
+
+#endif // BN_STRING_H
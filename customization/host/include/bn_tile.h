@@ -0,0 +1,15 @@
+#ifndef BN_TILE_H
+#define BN_TILE_H
+
+#include <stdint.h>
+
+// Host stand-in for bn::tile: 8x8 pixels at 4bpp (an 8bpp tile takes two)
+namespace bn
+{
+    struct tile
+    {
+        uint32_t data[8];
+    };
+}
+
+#endif // BN_TILE_H
@@ -0,0 +1,37 @@
+#ifndef BN_TIMER_H
+#define BN_TIMER_H
+
+#include <chrono>
+
+#include "bn_common.h"
+
+// Host stand-in for bn::timer. Ticks are nanoseconds of wall time, not GBA
+// clock cycles, so tick budgets and FrameScheduler cycle counts read as ns.
+namespace bn
+{
+    class timer
+    {
+    public:
+        timer() : _start(std::chrono::steady_clock::now()) {}
+
+        [[nodiscard]] int elapsed_ticks() const
+        {
+            return int(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - _start).count());
+        }
+
+        void restart() { _start = std::chrono::steady_clock::now(); }
+
+        int elapsed_ticks_with_restart()
+        {
+            const int result = elapsed_ticks();
+            restart();
+            return result;
+        }
+
+    private:
+        std::chrono::steady_clock::time_point _start;
+    };
+}
+
+#endif // BN_TIMER_H
@@ -0,0 +1,21 @@
+#ifndef BN_TIMERS_H
+#define BN_TIMERS_H
+
+#include "bn_common.h"
+
+// Host stand-in for bn::timers. Host timer ticks are nanoseconds (see
+// bn_timer.h), so a frame is the wall time of one GBA frame.
+namespace bn::timers
+{
+    [[nodiscard]] constexpr int ticks_per_second()
+    {
+        return 1000000000;
+    }
+
+    [[nodiscard]] constexpr int ticks_per_frame()
+    {
+        return 16742706;    // 280896 cycles at 16.78 MHz
+    }
+}
+
+#endif // BN_TIMERS_H
@@ -0,0 +1,15 @@
+#ifndef BN_UTILITY_H
+#define BN_UTILITY_H
+
+#include <utility>
+
+#include "bn_common.h"
+
+// Host stand-in for bn_utility.h
+namespace bn
+{
+    using std::swap;
+    using std::move;
+}
+
+#endif // BN_UTILITY_H
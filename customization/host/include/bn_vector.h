@@ -0,0 +1,104 @@
+#ifndef BN_VECTOR_H
+#define BN_VECTOR_H
+
+#include <vector>
+
+#include "bn_assert.h"
+
+// Host stand-in for bn::vector: a std::vector with its capacity reserved up
+// front, so element pointers stay valid like in the fixed-size original, and
+// with the same capacity asserts
+namespace bn
+{
+    template<typename Type, int MaxSize>
+    class vector
+    {
+    public:
+        using value_type = Type;
+        using iterator = typename std::vector<Type>::iterator;
+        using const_iterator = typename std::vector<Type>::const_iterator;
+
+        vector() { _items.reserve(MaxSize); }
+
+        vector(const vector& other) : vector() { _items = other._items; }
+        vector& operator=(const vector& other) { _items = other._items; return *this; }
+
+        [[nodiscard]] int size() const { return int(_items.size()); }
+        [[nodiscard]] static constexpr int max_size() { return MaxSize; }
+        [[nodiscard]] int available() const { return MaxSize - size(); }
+        [[nodiscard]] bool empty() const { return _items.empty(); }
+        [[nodiscard]] bool full() const { return size() == MaxSize; }
+
+        [[nodiscard]] Type* data() { return _items.data(); }
+        [[nodiscard]] const Type* data() const { return _items.data(); }
+
+        [[nodiscard]] iterator begin() { return _items.begin(); }
+        [[nodiscard]] iterator end() { return _items.end(); }
+        [[nodiscard]] const_iterator begin() const { return _items.begin(); }
+        [[nodiscard]] const_iterator end() const { return _items.end(); }
+
+        [[nodiscard]] Type& operator[](int index)
+        {
+            BN_ASSERT(index >= 0 && index < size(), "Invalid index: ", index);
+            return _items[index];
+        }
+
+        [[nodiscard]] const Type& operator[](int index) const
+        {
+            BN_ASSERT(index >= 0 && index < size(), "Invalid index: ", index);
+            return _items[index];
+        }
+
+        [[nodiscard]] Type& front() { return (*this)[0]; }
+        [[nodiscard]] const Type& front() const { return (*this)[0]; }
+        [[nodiscard]] Type& back() { return (*this)[size() - 1]; }
+        [[nodiscard]] const Type& back() const { return (*this)[size() - 1]; }
+
+        void push_back(const Type& value)
+        {
+            BN_ASSERT(!full(), "Vector is full");
+            _items.push_back(value);
+        }
+
+        void push_back(Type&& value)
+        {
+            BN_ASSERT(!full(), "Vector is full");
+            _items.push_back(static_cast<Type&&>(value));
+        }
+
+        template<typename... Args>
+        Type& emplace_back(Args&&... args)
+        {
+            BN_ASSERT(!full(), "Vector is full");
+            return _items.emplace_back(static_cast<Args&&>(args)...);
+        }
+
+        void pop_back()
+        {
+            BN_ASSERT(!empty(), "Vector is empty");
+            _items.pop_back();
+        }
+
+        iterator insert(const_iterator position, const Type& value)
+        {
+            BN_ASSERT(!full(), "Vector is full");
+            return _items.insert(position, value);
+        }
+
+        iterator erase(const_iterator position) { return _items.erase(position); }
+        iterator erase(const_iterator first, const_iterator last) { return _items.erase(first, last); }
+
+        void resize(int count)
+        {
+            BN_ASSERT(count >= 0 && count <= MaxSize, "Invalid count: ", count);
+            _items.resize(count);
+        }
+
+        void clear() { _items.clear(); }
+
+    private:
+        std::vector<Type> _items;
+    };
+}
+
+#endif // BN_VECTOR_H
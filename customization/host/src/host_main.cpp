@@ -0,0 +1,379 @@
+// ---------------------------------------------------------------------------
+// host_main.cpp
+// Entry point of the host build: runs a scripted scene of the game logic for
+// a number of frames and prints timings and the final state checksum.
+// ---------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "bn_camera_ptr.h"
+#include "bn_keypad.h"
+#include "bn_log.h"
+#include "bn_sprite_text_generator.h"
+
+#include "frame_scheduler.h"
+#include "game_input.h"
+#include "player.h"
+#include "entity_manager.h"
+#include "world_map.h"
+#include "damage_numbers.h"
+#include "sprite_render_state.h"
+#include "upgrade_graph.h"
+
+namespace
+{
+    using key_type = bn::keypad::key_type;
+
+    // Keys held for a number of frames; scripts loop
+    struct ScriptStep
+    {
+        int frames;
+        int keys;
+    };
+
+    constexpr int k_right = int(key_type::RIGHT);
+    constexpr int k_left  = int(key_type::LEFT);
+    constexpr int k_up    = int(key_type::UP);
+    constexpr int k_down  = int(key_type::DOWN);
+    constexpr int k_a     = int(key_type::A);
+
+    // Walk a loop around the main room, attacking on the way
+    constexpr ScriptStep k_walk_script[] = {
+        { 90, k_right }, { 1, k_right | k_a }, { 60, k_down }, { 1, k_a }, { 20, 0 },
+        { 120, k_left }, { 1, k_left | k_a }, { 60, k_up }, { 30, k_up | k_right }, { 1, k_a }, { 20, 0 },
+        { 30, k_down | k_left },
+    };
+
+    // Stay around the room center and keep attacking the enemies coming in
+    constexpr ScriptStep k_arena_script[] = {
+        { 20, 0 }, { 1, k_a }, { 12, k_left }, { 1, k_a }, { 12, k_right }, { 1, k_a },
+        { 12, k_up }, { 1, k_a }, { 12, k_down }, { 1, k_a },
+    };
+
+    // Long walks across the 128x128 streamed room, so the camera keeps
+    // scrolling new rows and columns into the cell ring
+    constexpr ScriptStep k_field_script[] = {
+        { 240, k_right }, { 240, k_down }, { 480, k_left }, { 1, k_a }, { 480, k_up },
+        { 240, k_right | k_down }, { 120, k_right }, { 1, k_a }, { 120, k_left },
+    };
+
+    struct Scene
+    {
+        const char* name;
+        const ScriptStep* steps;
+        int step_count;
+        RoomId room;
+        bool upgrade_fill;      // also fill the upgrade graph, one node per frame
+    };
+
+    constexpr Scene k_scenes[] = {
+        { "walk", k_walk_script, int(sizeof(k_walk_script) / sizeof(k_walk_script[0])), RoomId::MainRoom, false },
+        { "arena", k_arena_script, int(sizeof(k_arena_script) / sizeof(k_arena_script[0])), RoomId::MainRoom, false },
+        { "field", k_field_script, int(sizeof(k_field_script) / sizeof(k_field_script[0])), RoomId::Room14, false },
+        { "upgrades", k_arena_script, int(sizeof(k_arena_script) / sizeof(k_arena_script[0])), RoomId::MainRoom,
+          true },
+    };
+
+    // Fills the default upgrade graph one node per frame: the first node that
+    // can be unlocked has its curse cleared and is unlocked, and a new graph
+    // is started once every node is
+    class UpgradeFill
+    {
+    public:
+        void update()
+        {
+            for(int index = 0; index < _graph.node_count(); ++index)
+            {
+                UpgradeNode& node = _graph.node(index);
+
+                if(node.available && !node.unlocked)
+                {
+                    node.curse_cleared = true;
+                    BN_ASSERT(_graph.can_unlock(node.id), "Upgrade node can't be unlocked: ", node.id);
+
+                    _graph.unlock(node.id);
+                    ++_unlocks;
+                    return;
+                }
+            }
+
+            BN_ASSERT(_unlocks_in_graph() == _graph.node_count(), "Upgrade graph not filled");
+
+            _graph = UpgradeGraph::create_default();
+            ++_fills;
+        }
+
+        int fills() const { return _fills; }
+        int unlocks() const { return _unlocks; }
+
+    private:
+        UpgradeGraph _graph = UpgradeGraph::create_default();
+        int _fills = 0;
+        int _unlocks = 0;
+
+        int _unlocks_in_graph() const
+        {
+            int result = 0;
+
+            for(const UpgradeNode& node : _graph.nodes())
+            {
+                result += node.unlocked;
+            }
+
+            return result;
+        }
+    };
+
+    struct Options
+    {
+        int frames = 3600;
+        int enemies = 0;
+        const Scene* scene = &k_scenes[0];
+        bool quiet = false;
+        bool check_checksum = false;
+        uint32_t expected_checksum = 0;
+    };
+
+    void print_usage()
+    {
+        std::fprintf(stderr,
+                     "Usage: game_host [options]\n"
+                     "  --frames N       frames to simulate (default 3600)\n"
+                     "  --scene NAME     scripted scene: walk, arena, field, upgrades (default walk)\n"
+                     "  --enemies N      extra enemies spawned around the player\n"
+                     "  --checksum HEX   fail unless the final state checksum is HEX\n"
+                     "  --quiet          no game log\n");
+    }
+
+    bool parse_options(int argc, char** argv, Options& options)
+    {
+        for(int index = 1; index < argc; ++index)
+        {
+            const char* option = argv[index];
+            const char* value = index + 1 < argc ? argv[index + 1] : nullptr;
+
+            if(!std::strcmp(option, "--quiet"))
+            {
+                options.quiet = true;
+                continue;
+            }
+
+            if(!value)
+            {
+                return false;
+            }
+
+            ++index;
+
+            if(!std::strcmp(option, "--frames"))
+            {
+                options.frames = std::atoi(value);
+            }
+            else if(!std::strcmp(option, "--enemies"))
+            {
+                options.enemies = std::atoi(value);
+            }
+            else if(!std::strcmp(option, "--checksum"))
+            {
+                options.check_checksum = true;
+                options.expected_checksum = uint32_t(std::strtoul(value, nullptr, 16));
+            }
+            else if(!std::strcmp(option, "--scene"))
+            {
+                options.scene = nullptr;
+
+                for(const Scene& scene : k_scenes)
+                {
+                    if(!std::strcmp(scene.name, value))
+                    {
+                        options.scene = &scene;
+                    }
+                }
+
+                if(!options.scene)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return options.frames > 0 && options.enemies >= 0;
+    }
+
+    int script_keys(const Scene& scene, int frame)
+    {
+        int script_frames = 0;
+
+        for(int index = 0; index < scene.step_count; ++index)
+        {
+            script_frames += scene.steps[index].frames;
+        }
+
+        frame %= script_frames;
+
+        for(int index = 0; index < scene.step_count; ++index)
+        {
+            if(frame < scene.steps[index].frames)
+            {
+                return scene.steps[index].keys;
+            }
+
+            frame -= scene.steps[index].frames;
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+
+    if(!parse_options(argc, argv, options))
+    {
+        print_usage();
+        return 2;
+    }
+
+    host::set_logging(!options.quiet);
+    GameInput::initialize(GameInput::Mode::Live);
+
+    bn::camera_ptr camera = bn::camera_ptr::create(0, 0);
+    bn::sprite_text_generator text_gen;
+    DamageNumbers::initialize(&text_gen, &camera);
+
+    WorldMap* world = new WorldMap(options.scene->room);
+    world->set_camera(camera);
+
+    CharacterAppearance appearance;
+    PlayerSprite player_sprite(appearance, PlayerSprite::RenderMode::Composited);
+    Player player(&player_sprite, bn::fixed_point(0, 0), world);
+    player.attach_camera(camera);
+
+    EntityManager* entity_manager = new EntityManager(&player, world);
+    entity_manager->set_camera(camera);
+    entity_manager->enter_room(options.scene->room);
+
+    // Extra enemies on a ring around the player
+    for(int index = 0; index < options.enemies; ++index)
+    {
+        const int ring = 40 + (index / 8) * 24;
+        const bn::fixed_point offsets[] = {
+            { ring, 0 }, { -ring, 0 }, { 0, ring }, { 0, -ring },
+            { ring, ring }, { -ring, ring }, { ring, -ring }, { -ring, -ring },
+        };
+
+        if(!entity_manager->spawn_enemy(offsets[index % 8]))
+        {
+            BN_LOG("Enemy pool full after ", index, " extra enemies");
+            break;
+        }
+    }
+
+    FrameScheduler scheduler;
+    entity_manager->add_systems(scheduler);
+    scheduler.add<WorldMap, &WorldMap::update>(FramePhase::RenderSync, "world", *world);
+    scheduler.add(FramePhase::UI, "damage numbers", [](void*) { DamageNumbers::update(); }, nullptr);
+
+    UpgradeFill upgrade_fill;
+
+    if(options.scene->upgrade_fill)
+    {
+        scheduler.add<UpgradeFill, &UpgradeFill::update>(FramePhase::UI, "upgrade fill", upgrade_fill);
+    }
+
+    int64_t system_ticks[FrameScheduler::max_systems] = {};
+    int room_changes = 0;
+
+    SpriteRenderState::reset_counters();
+    const auto start = std::chrono::steady_clock::now();
+
+    for(int frame = 0; frame < options.frames; ++frame)
+    {
+        host::set_keypad(script_keys(*options.scene, frame));
+        GameInput::update();
+
+        scheduler.run_frame();
+        GameInput::add_checksum(entity_manager->state_checksum());
+
+        for(int id = 0; id < scheduler.system_count(); ++id)
+        {
+            system_ticks[id] += scheduler.system_ticks(id);
+        }
+
+        // Doors change rooms at once (no fade on the host)
+        if(auto door = world->check_door_collision(player_sprite.position()))
+        {
+            const RoomId target_room = door->room_id;
+            const bn::fixed_point spawn_pos = door->spawn_pos;
+
+            world->change_room(target_room);
+            entity_manager->enter_room(target_room);
+            player.update_sprite(spawn_pos, FacingDirection::Down);
+            ++room_changes;
+        }
+
+        world->update_prefetch();
+
+        if(!world->stream_matches_room())
+        {
+            std::fprintf(stderr, "Streamed room cells don't match the room at frame %d\n", frame);
+            return 1;
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const double total_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    int enemies_alive = 0;
+
+    for(const Enemy* enemy : entity_manager->enemies())
+    {
+        enemies_alive += enemy && enemy->is_alive();
+    }
+
+    std::printf("scene %s: %d frames in %.3f ms (%.0f ns/frame)\n", options.scene->name, options.frames,
+                total_ms, total_ms * 1e6 / options.frames);
+
+    for(int id = 0; id < scheduler.system_count(); ++id)
+    {
+        std::printf("  %-16s %10.0f ns/frame\n", scheduler.system_name(id),
+                    double(system_ticks[id]) / options.frames);
+    }
+
+    std::printf("  sprite updates: %.1f issued, %.1f skipped per frame\n",
+                double(SpriteRenderState::issued_updates()) / options.frames,
+                double(SpriteRenderState::skipped_updates()) / options.frames);
+
+    uint32_t checksum = entity_manager->state_checksum();
+
+    if(options.scene->upgrade_fill)
+    {
+        std::printf("  upgrade graph: %d fills, %d unlocks\n", upgrade_fill.fills(), upgrade_fill.unlocks());
+        checksum = GameInput::checksum(checksum, upgrade_fill.fills());
+        checksum = GameInput::checksum(checksum, upgrade_fill.unlocks());
+    }
+
+    std::printf("room %d, room changes %d, player health %d, enemies alive %d, sprites %d\n",
+                static_cast<int>(entity_manager->current_room()), room_changes, player.health(), enemies_alive,
+                bn::sprite_ptr::live_count());
+    std::printf("state checksum %08x\n", unsigned(checksum));
+
+    delete entity_manager;
+    delete world;
+
+    if(options.check_checksum && checksum != options.expected_checksum)
+    {
+        std::fprintf(stderr, "State checksum mismatch: expected %08x\n", unsigned(options.expected_checksum));
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+// ---------------------------------------------------------------------------
+// host_runtime.cpp
+// State behind the host stand-ins of the butano runtime (keypad, SRAM, log).
+// ---------------------------------------------------------------------------
+
+#include "bn_keypad.h"
+#include "bn_log.h"
+#include "bn_sram.h"
+
+namespace
+{
+    int held_keys = 0;
+    int previous_keys = 0;
+    bool logging_enabled = true;
+    uint8_t sram[host::sram_size];
+}
+
+namespace host
+{
+    void set_keypad(int keys)
+    {
+        previous_keys = held_keys;
+        held_keys = keys;
+    }
+
+    bool logging()
+    {
+        return logging_enabled;
+    }
+
+    void set_logging(bool enabled)
+    {
+        logging_enabled = enabled;
+    }
+
+    uint8_t* sram_data()
+    {
+        return sram;
+    }
+}
+
+namespace bn::keypad
+{
+    bool held(key_type key)
+    {
+        return held_keys & int(key);
+    }
+
+    bool pressed(key_type key)
+    {
+        return (held_keys & ~previous_keys) & int(key);
+    }
+
+    bool released(key_type key)
+    {
+        return (~held_keys & previous_keys) & int(key);
+    }
+}
@@ -0,0 +1,106 @@
+"""
+item_stubs.py
+Writes the bn_*_items_*.h headers butano generates from the graphics folders,
+for the host build: each item is declared with the same name and type, with
+the frame size and color depth of sprites and no pixel or color data.
+
+Usage: item_stubs.py --build=build/host/include graphics_dir [graphics_dir ...]
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+# Sprite color depth (bpp_mode in the item JSON) -> bn::bpp_mode
+BPP_MODES = {
+    'bpp_4': 'bn::bpp_mode::BPP_4',
+    'bpp_8': 'bn::bpp_mode::BPP_8',
+}
+
+# Item type -> (header prefix, namespace, item class, header of the item class)
+ITEM_TYPES = {
+    'sprite': ('bn_sprite_items_', 'bn::sprite_items', 'bn::sprite_item', 'bn_sprite_item.h'),
+    'sprite_palette': ('bn_sprite_palette_items_', 'bn::sprite_palette_items', 'bn::sprite_palette_item',
+                       'bn_sprite_palette_item.h'),
+    'regular_bg_tiles': ('bn_regular_bg_tiles_items_', 'bn::regular_bg_tiles_items', 'bn::regular_bg_tiles_item',
+                         'bn_regular_bg_tiles_item.h'),
+    'bg_palette': ('bn_bg_palette_items_', 'bn::bg_palette_items', 'bn::bg_palette_item', 'bn_bg_palette_item.h'),
+}
+
+
+def bmp_size(file_path):
+    with open(file_path, 'rb') as file:
+        header = file.read(26)
+
+    width, height = struct.unpack('<ii', header[18:26])
+    return width, abs(height)
+
+
+def item_header(name, item_type, info, bmp_path):
+    prefix, namespace, item_class, include = ITEM_TYPES[item_type]
+    guard = (prefix + name + '_H').upper()
+
+    if item_type == 'sprite':
+        width, height = bmp_size(bmp_path) if os.path.isfile(bmp_path) else (0, 0)
+        arguments = '(' + str(info.get('width', width)) + ', ' + str(info.get('height', height)) + ', ' + \
+                    BPP_MODES[info.get('bpp_mode', 'bpp_4')] + ')'
+    else:
+        arguments = ''
+
+    return ('// Generated by host/tools/item_stubs.py. Do not edit.\n\n'
+            '#ifndef ' + guard + '\n'
+            '#define ' + guard + '\n\n'
+            '#include "' + include + '"\n\n'
+            'namespace ' + namespace + '\n'
+            '{\n'
+            '    constexpr inline ' + item_class + ' ' + name + arguments + ';\n'
+            '}\n\n'
+            '#endif\n')
+
+
+def write_if_changed(file_path, text):
+    if os.path.isfile(file_path):
+        with open(file_path) as file:
+            if file.read() == text:
+                return
+
+    with open(file_path, 'w') as file:
+        file.write(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Host item header stubs.')
+    parser.add_argument('--build', required=True, help='output folder path')
+    parser.add_argument('graphics', nargs='+', help='graphics folder paths')
+    args = parser.parse_args()
+
+    os.makedirs(args.build, exist_ok=True)
+
+    for folder in args.graphics:
+        for file_name in sorted(os.listdir(folder)):
+            name, extension = os.path.splitext(file_name)
+
+            if extension != '.json':
+                continue
+
+            with open(os.path.join(folder, file_name)) as file:
+                info = json.load(file)
+
+            item_type = info.get('type')
+
+            if item_type not in ITEM_TYPES:
+                continue
+
+            prefix = ITEM_TYPES[item_type][0]
+            text = item_header(name, item_type, info, os.path.join(folder, name + '.bmp'))
+            write_if_changed(os.path.join(args.build, prefix + name + '.h'), text)
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except Exception as exception:
+        sys.stderr.write(str(exception) + '\n')
+        sys.exit(-1)
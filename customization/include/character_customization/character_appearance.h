@@ -43,6 +43,20 @@ struct CharacterAppearance
             bottom_color
         );
     }
+
+    // 16-color bank of 4bpp character sheets (see update_palette_bank)
+    void update_bank(bn::sprite_palette_ptr& pal, const uint8_t* bank_colors) const
+    {
+        update_palette_bank(
+            pal,
+            bank_colors,
+            body_color,
+            eyes_color,
+            hair_color,
+            top_color,
+            bottom_color
+        );
+    }
 };
 
 #endif // CHARACTER_APPEARANCE_H
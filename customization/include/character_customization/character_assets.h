@@ -6,9 +6,12 @@
 // Sprite assets for all character customization parts.
 // ---------------------------------------------------------------------------
 
+#include "bn_assert.h"
 #include "bn_sprite_item.h"
 
-// Character component sprite sheets
+// Character component sprite sheets, 4bpp: built from
+// graphics/character_customization/components by tools/character_sheets.py
+#include "generated_character_sheets.h"
 #include "bn_sprite_items_base_0.h"
 #include "bn_sprite_items_hair_long_0.h"
 #include "bn_sprite_items_hair_long_1.h"
@@ -99,6 +102,21 @@ inline constexpr const bn::sprite_item* k_bottom_options[] =
 };
 static_assert(sizeof(k_bottom_options)/sizeof(void*) == k_bottom_count);
 
+// 16-color palette bank of a character sheet (k_character_bank_colors row)
+inline int character_sheet_bank(const bn::sprite_item& item)
+{
+    for(const CharacterSheet& sheet : k_character_sheets)
+    {
+        if(sheet.item == &item)
+        {
+            return sheet.bank;
+        }
+    }
+
+    BN_ERROR("Not a character sheet");
+    return 0;
+}
+
 // ---------------------------------------------------------
 // Icon option arrays for customization screen
 // ---------------------------------------------------------
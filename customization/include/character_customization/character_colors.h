@@ -6,6 +6,8 @@
 // Predefined color ramps for skin and other features.
 // ---------------------------------------------------------------------------
 
+#include <stdint.h>
+
 #include "bn_color.h"
 #include "bn_sprite_palette_ptr.h"
 
@@ -87,6 +89,20 @@ constexpr int k_feature_color_count = static_cast<int>(FeatureColor::Count);
 const SkinColorRamp& get_skin_ramp(BodyColor color);
 const FeatureColorRamp& get_feature_ramp(FeatureColor color);
 
+// Ramp colors of the character palette layout (see character_colors.cpp):
+// indices 1-15, index 0 is transparent
+constexpr int k_character_ramp_colors = 16;
+
+void character_ramp_colors(
+    bn::color    colors[k_character_ramp_colors],
+    BodyColor    body_color,
+    FeatureColor eyes_color,
+    FeatureColor hair_color,
+    FeatureColor top_color,
+    FeatureColor bottom_color
+);
+
+// 8bpp palette with the character layout
 void update_palette(
     bn::sprite_palette_ptr& pal,
     BodyColor    body_color, 
@@ -96,4 +112,18 @@ void update_palette(
     FeatureColor bottom_color
 );
 
+constexpr int k_character_bank_size = 16;
+
+// 16-color bank of 4bpp character sheets: slot i takes the color of layout
+// index bank_colors[i] when it is a ramp index (fixed colors are left as is)
+void update_palette_bank(
+    bn::sprite_palette_ptr& pal,
+    const uint8_t*          bank_colors,
+    BodyColor               body_color,
+    FeatureColor            eyes_color,
+    FeatureColor            hair_color,
+    FeatureColor            top_color,
+    FeatureColor            bottom_color
+);
+
 #endif // CHARACTER_COLORS_H
@@ -0,0 +1,92 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdint.h>
+
+#include "bn_optional.h"
+#include "bn_timer.h"
+#include "bn_timers.h"
+
+#include "frame_scheduler.h"
+
+// -----------------------------------------------------------------------------
+// Benchmark scenarios
+// -----------------------------------------------------------------------------
+// Building with -DBENCHMARK_SCENARIO=\"<name>\" (see make bench) turns the ROM
+// into one benchmark scenario: its input comes from a script instead of the
+// keypad, and main.cpp sets the scenario up:
+//
+// - chase: 32 enemies chasing the player around the main room
+// - doors: the player is put on a door as soon as a room is entered
+// - menu:  a new customization menu key every other frame
+//
+// Every frame is timed from frame_started() to frame_ended() (the work done
+// between two bn::core::update() calls), and the phases recorded during it
+// are summed. Times are bn::timer ticks (64 CPU cycles each), so the budget
+// of a frame is bn::timers::ticks_per_frame(). After `frames` frames the
+// results are logged through BN_LOG as "bench ..." lines, which
+// tools/bench_runner.py turns into JSON.
+//
+// Every function does nothing when no scenario was initialized.
+// -----------------------------------------------------------------------------
+class Benchmark
+{
+public:
+    enum class Scenario
+    {
+        None,
+        Chase,
+        Doors,
+        MenuSpam
+    };
+
+    static constexpr int frames        = 1800;
+    static constexpr int frame_ticks   = bn::timers::ticks_per_frame();
+    static constexpr int chase_enemies = 32;
+    static constexpr int max_phases    = 12;
+
+    // Scenario by name; input then comes from its script
+    static void initialize(const char* name);
+
+    static bool active() { return _scenario != Scenario::None; }
+    static Scenario scenario() { return _scenario; }
+
+    // Ticks a phase used this frame. Phases are told apart by the address of
+    // their name, a string literal without spaces.
+    static void record(const char* phase, int ticks);
+
+    // Ticks of every frame phase of the scheduler's last frame
+    static void record(const FrameScheduler& scheduler);
+
+    // Around bn::core::update(). Once the last frame ended, the results are
+    // logged and frame_ended() doesn't return.
+    static void frame_ended();
+    static void frame_started();
+
+private:
+    // Ticks of a phase over the frames it ran in
+    struct Phase
+    {
+        const char* name;
+        int ticks;          // this frame
+        int frames;
+        int64_t sum;
+        int max;
+    };
+
+    static Scenario _scenario;
+    static const char* _name;
+    static Phase _phases[max_phases];
+    static int _phase_count;
+
+    static bn::optional<bn::timer> _timer;
+    static int _frame;
+    static int64_t _work_sum;
+    static int _work_max;
+    static int _frames_over_budget;
+
+    static int _keys(int frame);
+    [[noreturn]] static void _report();
+};
+
+#endif // BENCHMARK_H
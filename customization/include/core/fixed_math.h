@@ -0,0 +1,53 @@
+#ifndef FIXED_MATH_H
+#define FIXED_MATH_H
+
+#include "bn_common.h"
+#include "bn_fixed.h"
+#include "bn_fixed_point.h"
+
+// -----------------------------------------------------------------------------
+// Fixed point vector math
+// -----------------------------------------------------------------------------
+// Table based replacements for bn::sqrt and divisions in per-entity code: the
+// ARM7 has no hardware divide, so every division or square root is a slow
+// software routine. Everything here is built on small lookup tables and
+// multiplies, compiled as ARM code in IWRAM (fixed_math.bn_iwram.cpp).
+//
+// Angles are binary angles: k_turn units per turn, 0 along +x and k_turn / 4
+// along +y (down on screen).
+//
+// Precision: rsqrt and normalize are within 0.1% (plus the rounding of the
+// result), atan2 within 0.05 degrees, sin and cos within 2 / 4096.
+// -----------------------------------------------------------------------------
+namespace fixed_math
+{
+    constexpr int k_turn = 65536;
+
+    // 1 / sqrt(value), value > 0
+    [[nodiscard]] BN_CODE_IWRAM bn::fixed rsqrt(bn::fixed value);
+
+    // Vector of length 1 with the direction of vector, (0, 0) for (0, 0)
+    [[nodiscard]] BN_CODE_IWRAM bn::fixed_point normalize(const bn::fixed_point& vector);
+
+    // Sine and cosine of a binary angle
+    [[nodiscard]] BN_CODE_IWRAM bn::fixed sin(int angle);
+    [[nodiscard]] BN_CODE_IWRAM bn::fixed cos(int angle);
+
+    // Binary angle (0 .. k_turn - 1) of the vector (x, y), 0 for (0, 0)
+    [[nodiscard]] BN_CODE_IWRAM int atan2(bn::fixed y, bn::fixed x);
+
+    // Unit vector (cos, sin) of a binary angle
+    [[nodiscard]] BN_CODE_IWRAM bn::fixed_point unit_vector(int angle);
+
+    // Nearest of directions evenly spaced directions (a power of two, e.g.
+    // 8, 16 or 32), direction 0 being +x
+    [[nodiscard]] BN_CODE_IWRAM int quantize_direction(const bn::fixed_point& vector, int directions);
+
+    // Unit vector of a direction returned by quantize_direction
+    [[nodiscard]] inline bn::fixed_point direction_vector(int direction, int directions)
+    {
+        return unit_vector(direction * (k_turn / directions));
+    }
+}
+
+#endif // FIXED_MATH_H
@@ -0,0 +1,9 @@
+#ifndef FIXED_MATH_BENCHMARK_H
+#define FIXED_MATH_BENCHMARK_H
+
+// Time every fixed_math function against the bn:: code it replaces and log
+// the average CPU cycles per call (build with -DFIXED_MATH_BENCHMARK to run it
+// at startup)
+void run_fixed_math_benchmark();
+
+#endif // FIXED_MATH_BENCHMARK_H
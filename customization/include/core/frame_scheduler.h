@@ -0,0 +1,88 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include "bn_vector.h"
+
+// Frame phases, run in this order
+enum class FramePhase
+{
+    Input,
+    AI,
+    Movement,      // movement and physics
+    Combat,
+    Animation,
+    RenderSync,    // camera, sprite order, VRAM updates
+    UI
+};
+
+constexpr int FRAME_PHASE_COUNT = static_cast<int>(FramePhase::UI) + 1;
+
+// Short name of a phase for profiling output, e.g. "move"
+const char* frame_phase_name(FramePhase phase);
+
+// -----------------------------------------------------------------------------
+// Frame scheduler
+// -----------------------------------------------------------------------------
+// Every per-frame system registers once into a phase, and run_frame() runs
+// each of them exactly once per frame, phase by phase. A system can't be
+// registered twice and run_frame() can't be nested, so nothing gets ticked
+// twice in a frame.
+//
+// The bn::timer ticks spent by each system in the last frame are kept for
+// profiling.
+// -----------------------------------------------------------------------------
+class FrameScheduler
+{
+public:
+    static constexpr int max_systems = 16;
+
+    using system_function = void(*)(void* context);
+
+    // Register function(context) into a phase, returns the system id.
+    // Systems of the same phase run in registration order.
+    int add(FramePhase phase, const char* name, system_function function, void* context);
+
+    // Register a member function, e.g. add<WorldMap, &WorldMap::update>(...)
+    template<typename Type, void (Type::*Method)()>
+    int add(FramePhase phase, const char* name, Type& object)
+    {
+        return add(phase, name, [](void* context)
+        {
+            (static_cast<Type*>(context)->*Method)();
+        }, &object);
+    }
+
+    // Run every system once, phase by phase
+    void run_frame();
+
+    int system_count() const { return _systems.size(); }
+    const char* system_name(int id) const { return _systems[id].name; }
+    FramePhase system_phase(int id) const { return _systems[id].phase; }
+
+    // bn::timer ticks used in the last frame
+    int system_ticks(int id) const { return _systems[id].ticks; }
+    int phase_ticks(FramePhase phase) const { return _phase_ticks[static_cast<int>(phase)]; }
+    int frame_ticks() const { return _frame_ticks; }
+
+private:
+    struct System
+    {
+        system_function function;
+        void* context;
+        const char* name;
+        FramePhase phase;
+        int ticks;
+    };
+
+    // Indexed by system id
+    bn::vector<System, max_systems> _systems;
+
+    // System ids sorted by phase, then by registration order
+    bn::vector<int, max_systems> _run_order;
+
+    int _phase_ticks[FRAME_PHASE_COUNT] = {};
+    int _frame_ticks = 0;
+    bool _running = false;
+};
+
+#endif // FRAME_SCHEDULER_H
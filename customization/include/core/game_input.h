@@ -0,0 +1,117 @@
+#ifndef GAME_INPUT_H
+#define GAME_INPUT_H
+
+#include <stdint.h>
+
+#include "bn_keypad.h"
+
+// -----------------------------------------------------------------------------
+// Game input
+// -----------------------------------------------------------------------------
+// Every game input read goes through here instead of bn::keypad, so a session
+// can be recorded and replayed frame by frame:
+//
+// - Live:   keypad only
+// - Record: keypad, saved to SRAM at every checkpoint (run-length encoded:
+//           one entry per change of the held keys)
+// - Replay: the session saved in SRAM, then the keypad once it runs out
+// - Script: keys given by a function of the frame (benchmarks)
+//
+// The game folds a checksum of its simulation state into the session every
+// gameplay frame (add_checksum). Recording saves the running checksum every
+// checkpoint_frames frames and replaying compares against it, so a replay is
+// known to be bit-exact or where it first diverged.
+// -----------------------------------------------------------------------------
+class GameInput
+{
+public:
+    enum class Mode
+    {
+        Live,
+        Record,
+        Replay,
+        Script
+    };
+
+    // Keys held in a frame (bn::keypad::key_type bits)
+    using key_script = int(*)(int frame);
+
+    static constexpr int max_runs          = 4096;
+    static constexpr int max_checkpoints   = 2048;
+    static constexpr int checkpoint_frames = 64;
+
+    // Replay falls back to Live when SRAM holds no session
+    static void initialize(Mode mode);
+
+    // Script mode: script(frame) gives the held keys of every frame
+    static void initialize_script(key_script script);
+    static Mode mode() { return _mode; }
+
+    // Sample the input of the next frame, once per frame after bn::core::update()
+    static void update();
+
+    // Frames sampled since initialize()
+    static int frame() { return _frame; }
+
+    static bool held(bn::keypad::key_type key)     { return _keys & int(key); }
+    static bool pressed(bn::keypad::key_type key)  { return (_keys & ~_previous_keys) & int(key); }
+    static bool released(bn::keypad::key_type key) { return (~_keys & _previous_keys) & int(key); }
+
+    // Fold the state checksum of one gameplay frame into the session
+    static void add_checksum(uint32_t checksum);
+
+    // False once a replay checkpoint didn't match the recording
+    static bool replay_matches() { return _replay_matches; }
+
+    // Checksum helpers (FNV-1a)
+    static constexpr uint32_t checksum_seed = 2166136261u;
+
+    [[nodiscard]] static uint32_t checksum(uint32_t checksum, int value)
+    {
+        for(int byte = 0; byte < 4; ++byte)
+        {
+            checksum = (checksum ^ ((uint32_t(value) >> (byte * 8)) & 0xFF)) * 16777619u;
+        }
+
+        return checksum;
+    }
+
+private:
+    // Held keys for frames frames in a row
+    struct Run
+    {
+        uint16_t keys;
+        uint16_t frames;
+    };
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t frames;
+        uint16_t runs;
+        uint16_t checkpoints;
+    };
+
+    static Mode _mode;
+    static key_script _script;
+    static int _frame;
+    static int _keys;
+    static int _previous_keys;
+
+    static Header _header;      // recorded (Record) or loaded (Replay) session
+    static Run _run;            // Record: open run, Replay: run being played
+    static int _run_index;
+    static int _run_frames_left;
+
+    static uint32_t _checksum;
+    static int _checksum_frames;
+    static bool _replay_matches;
+
+    static int _read_keypad();
+    static void _record(int keys);
+    static int _replay();
+    static void _save();        // open run and header
+    static void _finish_replay();
+};
+
+#endif // GAME_INPUT_H
@@ -0,0 +1,32 @@
+#ifndef HOT_CODE_H
+#define HOT_CODE_H
+
+// -----------------------------------------------------------------------------
+// Hot code placement
+// -----------------------------------------------------------------------------
+// Functions on the per-frame hot paths are grouped in sets, each one kept in
+// its own .inc file built by a pair of translation units:
+//
+// - collision: WorldMap tile and sweep queries (src/tilemap/world_map_collision.inc)
+// - combat:    hitbox tests, attacks and bump resolution (src/entity/combat.inc)
+//
+// A set built with HOT_CODE_<SET>=1 is compiled by its .bn_iwram.cpp file as
+// ARM code in IWRAM (no ROM wait states, 32-bit fetches), with 0 by its .cpp
+// file as Thumb code in ROM. The sets are chosen in the Makefile (HOTCODE), so
+// moving one in or out of IWRAM is a build option, and `make hotcode-report`
+// lists what ended up in IWRAM.
+//
+// Small helpers called from a set (Hitbox::center, hitboxes_intersect,
+// WorldMap::pixel_width, ...) are inline in their headers, so the set inlines
+// them instead of calling back into ROM.
+// -----------------------------------------------------------------------------
+
+#ifndef HOT_CODE_COLLISION
+    #define HOT_CODE_COLLISION 0
+#endif
+
+#ifndef HOT_CODE_COMBAT
+    #define HOT_CODE_COMBAT 0
+#endif
+
+#endif // HOT_CODE_H
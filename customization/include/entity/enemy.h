@@ -9,28 +9,45 @@
 
 class WorldMap;
 class EntitySprite;
+class FlowField;
 
 class Enemy : public Entity
 {
 public:
+    // Half width of the hurt box, which is also the width of the feet box
+    // swept against the map
+    static constexpr int hurt_half_width = 6;
+
     Enemy(EntitySprite* sprite, const WorldMap* world_map);
 
     void attach_camera(const bn::camera_ptr& camera);
-    void update();
+
+    // Frame phases
+    void update_ai() override;
+    void update_movement() override;
+    void update_animation() override;
 
     void set_target(Entity* target) { _target = target; }
 
+    // Target alive and close enough to be chased
+    bool is_pursuing() const;
+
+    bn::fixed max_speed() const { return _max_speed; }
+
+    // Shared distance field toward the target, used to route around walls
+    void set_flow_field(const FlowField* flow_field) { _flow_field = flow_field; }
+
 private:
     bn::fixed_point _get_feet_position(const bn::fixed_point& old_pos, const bn::fixed_point& new_pos) const override;
 
-    void _update_ai();
-    void _chase(const bn::fixed_point& to_target);          // kept as fallback
-    void _apply_movement_animation();                       // now also does collisions
+    void _chase(const bn::fixed_point& to_target);
+    void _apply_movement();                                 // swept against the map
 
     void _update_path_and_velocity(const bn::fixed_point& my_pos,
                                    const bn::fixed_point& target_pos);
 
     Entity* _target = nullptr;
+    const FlowField* _flow_field = nullptr;
     FacingDirection _direction;
 
     bn::fixed_point _velocity;
@@ -42,10 +59,6 @@ private:
     int _attack_cooldown_max;
 
     bool _start_attack = false;
-
-    // pathfinding: recalc direction only every few frames
-    int _path_recalc_timer       = 0;
-    static constexpr int k_path_recalc_interval = 10;
 };
 
 #endif // ENEMY_H
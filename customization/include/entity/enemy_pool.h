@@ -0,0 +1,60 @@
+#ifndef ENEMY_POOL_H
+#define ENEMY_POOL_H
+
+#include "enemy.h"
+#include "enemy_sprite.h"
+#include "spatial_grid.h"
+
+#include "bn_fixed_point.h"
+#include "bn_optional.h"
+#include "bn_vector.h"
+
+class WorldMap;
+
+// -----------------------------------------------------------------------------
+// Enemy pool
+// -----------------------------------------------------------------------------
+// Fixed storage for the enemies of the current room. Each slot holds an Enemy
+// and its EnemySprite, built in place on acquire() and destroyed on release(),
+// so only live enemies hold sprites (OAM) while RAM stays fixed no matter how
+// many rooms have spawn tables.
+//
+// There is a slot for every spatial grid item. Hardware sprites run out first
+// (128 for everything on screen), so acquire() also fails when another enemy
+// would leave less than reserved_sprites for the player and the UI.
+// -----------------------------------------------------------------------------
+class EnemyPool
+{
+public:
+    static constexpr int capacity = SpatialGrid::max_items;
+    static constexpr int sprites_per_enemy = 2;    // body and health bar
+    static constexpr int reserved_sprites  = 40;   // player layers, damage numbers, menus (not the
+                                                   // profiler overlay, which skips what doesn't fit)
+
+    EnemyPool();
+
+    EnemyPool(const EnemyPool&) = delete;
+    EnemyPool& operator=(const EnemyPool&) = delete;
+
+    // Build an enemy in a free slot, or return nullptr if the pool is full or
+    // the sprites are used up
+    Enemy* acquire(const bn::fixed_point& pos, const WorldMap* world_map);
+
+    // Destroy an enemy built by acquire() and free its slot
+    void release(Enemy* enemy);
+
+    int size() const { return capacity - _free_slots.size(); }
+    bool full() const { return _free_slots.empty(); }
+
+private:
+    struct Slot
+    {
+        bn::optional<EnemySprite> sprite;
+        bn::optional<Enemy>       enemy;
+    };
+
+    Slot _slots[capacity];
+    bn::vector<int, capacity> _free_slots;
+};
+
+#endif // ENEMY_POOL_H
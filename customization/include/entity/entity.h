@@ -8,9 +8,11 @@
 
 #include "bn_fixed_point.h"
 #include "bn_fixed.h"
+#include "bn_fixed_rect.h"
 #include "bn_math.h"
 
 class WorldMap;
+struct SweepResult;
 
 class Entity 
 {
@@ -27,13 +29,23 @@ public:
 
     virtual void attach_camera(const bn::camera_ptr& camera);
 
-    // Per-frame update (call this from sub-classes)
-    void update_entity();
+    // Per-frame phases, each run once per frame through EntityManager.
+    // Sub-classes overriding update_movement or sync_render call the base
+    // version (knockback, sprite order and health bar).
+    virtual void update_input() {}
+    virtual void update_ai() {}
+    virtual void update_movement();
+    virtual void update_animation() = 0;
+    virtual void sync_render();
 
     int health() const     { return _health; }
     int max_health() const { return _max_health; }
+    void set_health(int health) { _health = bn::clamp(health, 0, _max_health); }
     bool is_alive() const  { return _health > 0; }
 
+    // Dead and done playing the death animation
+    bool is_finished() const { return !is_alive() && _sprite && _sprite->death_finished(); }
+
     bool is_invulnerable() const { return _invuln_timer > 0; }
 
     int damage() const          { return _damage; }
@@ -48,6 +60,9 @@ public:
     bn::fixed_point position() const;
     void move_by(const bn::fixed_point& delta);
 
+    // Where the entity touches the ground (what collides with the map)
+    bn::fixed_point feet_position() const;
+
     bool is_attacking() const;
 
     // Any overlap between our hurt box and the other's hurt box
@@ -59,6 +74,10 @@ public:
     void set_active(bool active);
     bool is_active() const { return _active; }
 
+    // Rank in the Y-sort of EntityManager (0: in front), -1 until sorted
+    int depth() const { return _depth; }
+    void set_depth(int depth);
+
 protected:
     EntitySprite* _sprite;
     const WorldMap* _world_map;
@@ -72,12 +91,25 @@ protected:
 
     bool _active = true;
 
+    int _depth = -1;
+
     Hitbox _hurt_box;
     Hitbox _attack_box;
 
     bn::fixed_point _clamp_to_world(const bn::fixed_point& candidate) const;
     virtual bn::fixed_point _get_feet_position(const bn::fixed_point& old_pos, const bn::fixed_point& new_pos) const = 0;
-    bool _can_stand_at(const bn::fixed_point& old_pos, const bn::fixed_point& new_pos) const;
+
+    // Box covering the feet probes of a sprite at pos (both moving up and down)
+    bn::fixed_rect _feet_box(const bn::fixed_point& pos) const;
+
+    // Sweep the feet box from pos by delta against the world map
+    SweepResult _sweep(const bn::fixed_point& pos, const bn::fixed_point& delta) const;
+
+    void _set_knockback(int duration_frames, bn::fixed strength)
+    {
+        _knockback_duration = duration_frames;
+        _knockback_strength = strength;
+    }
 
 private:
     void _tick_invulnerability();
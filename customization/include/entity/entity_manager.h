@@ -4,62 +4,114 @@
 #include "entity.h"
 #include "player.h"
 #include "enemy.h"
+#include "enemy_pool.h"
+#include "spatial_grid.h"
+#include "flow_field.h"
+#include "room_graph.h"
+#include "frame_scheduler.h"
 #include "world_map_data.h"
 #include "bn_vector.h"
+#include "bn_optional.h"
+#include "bn_camera_ptr.h"
 
 class EntityManager
 {
 public:
-    static constexpr int max_enemies = 32;
-    static constexpr int max_rooms   = ROOM_COUNT;
+    static constexpr int max_enemies   = EnemyPool::capacity;
+    static constexpr int max_followers = 16;
 
-    EntityManager(Player* player = nullptr, RoomId room = RoomId::MainRoom);
+    static_assert(max_enemies <= SpatialGrid::max_items, "Enemy pool is bigger than the spatial grid");
 
-    void set_player(Player* player) { _player = player; }
+    EntityManager(Player* player, const WorldMap* world_map);
+
+    void set_player(Player* player);
     Player* player() const { return _player; }
 
-    // Tell the manager which room is currently active.
-    // Call this whenever the player enters a new room.
-    void set_current_room(RoomId room);
+    // Camera attached to spawned enemies
+    void set_camera(const bn::camera_ptr& camera) { _camera = camera; }
+
+    // Release the enemies of the current room and spawn the ones listed in
+    // the spawn table of room. Call this whenever the player enters a room.
+    // Enemies chasing the player follow it through the doors and show up
+    // after the time it takes them to walk there.
+    void enter_room(RoomId room);
     RoomId current_room() const { return _current_room; }
 
-    void add_enemy(Enemy* enemy)
-    {
-        add_enemy(enemy, _current_room);
-    }
-    void add_enemy(Enemy* enemy, RoomId room);
+    // Spawn an enemy in the current room (nullptr if the pool is full)
+    Enemy* spawn_enemy(const bn::fixed_point& pos);
 
-    // Clears enemies only in the current room.
+    // Releases every enemy of the current room
     void clear_enemies();
 
     bn::vector<Enemy*, max_enemies>& enemies() { return _enemies; }
     const bn::vector<Enemy*, max_enemies>& enemies() const { return _enemies; }
 
-    // Per-frame update
-    void update();
+    // Register the per-frame phases below into a scheduler
+    void add_systems(FrameScheduler& scheduler);
+
+    // Per-frame phases (player and enemies of the current room)
+    void update_input();
+    void update_ai();           // followers, flow field and enemy AI
+    void update_movement();     // movement, grid and bumps
+    void update_combat();
+    void update_animation();
+    void sync_render();
+
+    // Checksum of the simulation state (room, positions, health and
+    // followers), to check that a replayed session matches its recording
+    uint32_t state_checksum() const;
 
 private:
     Player* _player = nullptr;
 
-    // Enemies in the current active room (for fast iteration)
+    const WorldMap* _world_map = nullptr;
+    bn::optional<bn::camera_ptr> _camera;
+
+    // Enemies in the current active room (for fast iteration). Released
+    // enemies leave a null entry until the room is left.
     bn::vector<Enemy*, max_enemies> _enemies;
+    EnemyPool _pool;
 
-    // Per-room enemy lists
-    struct RoomEnemies
+    RoomId _current_room = RoomId::MainRoom;
+
+    // Enemies walking through other rooms toward the player's room (not
+    // simulated, only timed)
+    struct Follower
     {
-        RoomId room;
-        bn::vector<Enemy*, max_enemies> enemies;
+        RoomId    room;         // room it walks through
+        int       door;         // door of that room it walks to
+        int       frames;       // frames left until it goes through the door
+        int       health;
+        bn::fixed speed;
     };
 
-    bn::vector<RoomEnemies, max_rooms> _rooms;
-    RoomId _current_room;
-
-    // Look up or create the bucket for a room
-    RoomEnemies* _find_room_bucket(RoomId room);
-    RoomEnemies& _ensure_room_bucket(RoomId room);
-
-    // Internal update phases
-    void _update_all();
+    RoomGraph _room_graph;
+    bn::vector<Follower, max_followers> _followers;
+
+    // Distances to the player's feet, shared by every enemy
+    FlowField _flow_field;
+
+    // The player and the enemies of the current room, front to back (bigger
+    // feet Y first). Kept from one frame to the next, so the sort has little
+    // to move.
+    bn::vector<Entity*, max_enemies + 1> _depth_order;
+
+    // Broadphase: alive enemies of the current room by hurt box center
+    // (items are indices into _enemies)
+    SpatialGrid _grid;
+
+    // How far an enemy attack box reaches from its hurt box center
+    bn::fixed _attack_reach_x;
+    bn::fixed _attack_reach_y;
+
+    // Internal update steps
+    void _update_grid();
+    void _remove_depth(Entity* entity);
+    void _sort_depth();
+    void _release_finished();
+    void _add_follower(const Enemy& enemy, RoomId room);
+    bool _route_follower(Follower& follower, const bn::fixed_point& pos);
+    void _update_followers();
     void _handle_player_attacks_enemies();
     void _handle_enemy_attacks_player();
     void _handle_bumps();
@@ -67,9 +119,13 @@ private:
     // Collision resolution
     void _separate_pair(Entity* a, Entity* b);
 
-    // Utility iteration helper for all alive enemies
+    // Iterate the player and the enemies of the current room
+    template<typename Func>
+    void _for_each_entity(Func&& func);
+
+    // Iterate the alive enemies whose hurt box may overlap an area
     template<typename Func>
-    void _for_each_alive_enemy(Func&& func);
+    void _for_each_enemy_near(const bn::fixed_rect& area, Func&& func);
 };
 
 #endif // ENTITY_MANAGER_H
@@ -0,0 +1,97 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <stdint.h>
+
+#include "bn_point.h"
+#include "bn_optional.h"
+
+#include "world_map_data.h"
+
+class WorldMap;
+
+// -----------------------------------------------------------------------------
+// Flow field
+// -----------------------------------------------------------------------------
+// Distance in tiles from every walkable tile of a size x size window of the
+// room to a goal tile (e.g. the player's feet), found by a breadth-first
+// search over the collision grid. Any number of enemies can then steer toward
+// the goal by reading the cells around them, and they route around walls.
+//
+// Tiles where a box clearance pixels wide on each side (an enemy feet box)
+// centered on the tile would touch a wall are left out of the search, so
+// enemies are not steered into corridors they don't fit in or along walls
+// they would scrape.
+//
+// The field is rebuilt when the room collision changes, and repaired when the
+// goal tile moves: the old distances plus the distance between both goals
+// are still the length of a path to the new goal, so only the tiles that get
+// closer are visited, in place. Rebuilds and repairs are spread over several
+// frames (budget cells per update). The last finished field stays readable
+// during a rebuild, and changes made meanwhile start the next one.
+//
+// Regular rooms fit the window; streamed rooms get a window centered on the
+// goal, moved when the goal gets near its edges.
+// -----------------------------------------------------------------------------
+class FlowField
+{
+public:
+    static constexpr int size  = ROOM_WIDTH;        // tiles
+    static constexpr int cells = size * size;
+    static constexpr int build_budget_cells = 512;  // cells expanded per update
+
+    // clearance: half width in pixels of the boxes steered by the field
+    explicit FlowField(const WorldMap* world_map, int clearance = 0);
+
+    // Continue the current rebuild or repair expanding at most budget cells,
+    // or start one if goal_tile or the collision changed
+    void update(const bn::point& goal_tile, int budget = build_budget_cells);
+
+    // Distance to the goal of the last finished field, -1 if the tile is not
+    // reachable or outside the window
+    int distance(int tx, int ty) const;
+
+    // 4-connected neighbour one step closer to the goal. From a tile left out
+    // of the search (e.g. a box flush against a wall), the closest reachable
+    // neighbour. Nothing on the goal, or if no neighbour is reachable.
+    bn::optional<bn::point> next_tile(const bn::point& tile) const;
+
+private:
+    static constexpr int16_t unreached = -32768;
+    static constexpr int16_t blocked   = -32767;
+    static constexpr int max_bias = 16384;      // rebuild before stored values can wrap
+
+    const WorldMap* _world_map;
+    int _clearance_tiles;                       // tiles on each side of a tile that must be free
+
+    // Front field (read) and back field (being rebuilt). Front distances are
+    // stored minus _bias, so a repair can raise all of them at once.
+    int16_t _distances[2][cells];
+    bn::point _origins[2];              // top-left room tile of each window
+    int _front = 0;
+    int _bias = 0;
+    bool _front_valid = false;
+
+    // Breadth-first search of the back field, or of the front one while it
+    // is repaired (indices into the window)
+    uint16_t _queue[cells];
+    int _queue_head = 0;
+    int _queue_tail = 0;
+    bool _building = false;
+    bool _repairing = false;
+
+    // What the last rebuild or repair was started for
+    bn::point _goal;
+    RoomId _room = RoomId::MainRoom;
+    int _revision = -1;
+
+    bn::point _window_origin(const bn::point& goal_tile) const;
+    bool _is_clear(int tx, int ty) const;
+
+    void _start(const bn::point& goal_tile);
+    bool _start_repair(const bn::point& goal_tile);
+    void _expand(int budget);
+    void _visit(int field, int x, int y, int distance);
+};
+
+#endif // FLOW_FIELD_H
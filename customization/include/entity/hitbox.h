@@ -3,6 +3,7 @@
 
 #include "bn_fixed.h"
 #include "bn_fixed_point.h"
+#include "bn_math.h"
 
 struct Hitbox
 {
@@ -16,13 +17,30 @@ struct Hitbox
     Hitbox(bn::fixed ox, bn::fixed oy, bn::fixed hw, bn::fixed hh);
 
     // Returns world-space center of the hitbox
-    bn::fixed_point center(const bn::fixed_point& sprite_pos) const;
+    bn::fixed_point center(const bn::fixed_point& sprite_pos) const
+    {
+        return bn::fixed_point(
+            sprite_pos.x() + offset_x,
+            sprite_pos.y() + offset_y
+        );
+    }
 };
 
 // Simple AABB intersection test
-bool hitboxes_intersect(
+inline bool hitboxes_intersect(
     const Hitbox& a, const bn::fixed_point& pos_a,
     const Hitbox& b, const bn::fixed_point& pos_b
-);
+) {
+    const bn::fixed_point ca = a.center(pos_a);
+    const bn::fixed_point cb = b.center(pos_b);
+
+    const bn::fixed dx = ca.x() - cb.x();
+    const bn::fixed dy = ca.y() - cb.y();
+
+    const bn::fixed sum_hw = a.half_width  + b.half_width;
+    const bn::fixed sum_hh = a.half_height + b.half_height;
+
+    return (bn::abs(dx) <= sum_hw) && (bn::abs(dy) <= sum_hh);
+}
 
 #endif // HITBOX_H
@@ -17,8 +17,12 @@ class Player : public Entity
 public:
     Player(PlayerSprite* sprite, const bn::fixed_point& start_pos, const WorldMap* world);
 
-    // Update with collisions + camera against the saved world map
-    void update();
+    // Frame phases: keypad, movement with collisions, animation, then the
+    // camera against the saved world map
+    void update_input() override;
+    void update_movement() override;
+    void update_animation() override;
+    void sync_render() override;
 
     // Attach a camera that follows the player (and is clamped to map edges)
     void attach_camera(const bn::camera_ptr& camera);
@@ -48,11 +52,16 @@ private:
     // Sprite/animation handler
     PlayerSprite* _sprite;
 
-    static constexpr bn::fixed k_speed = bn::fixed(0.6);
+    // Tuned when the player was updated twice per frame: per frame values
+    // are kept (0.6 px twice a frame, 60 invulnerability ticks, ...)
+    static constexpr bn::fixed k_speed = bn::fixed(1.2);
+    static constexpr int k_invuln_frames = 30;
+    static constexpr int k_knockback_frames = 3;
+    static constexpr bn::fixed k_knockback_strength = 4;
 
     bn::fixed_point _get_feet_position(const bn::fixed_point& old_pos, const bn::fixed_point& new_pos) const override;
 
-    void _handle_input();     // read keypad, set _move_dx/_move_dy
+    void _handle_input();     // read GameInput, set _move_dx/_move_dy
     void _apply_movement(bn::fixed_point& new_pos);
     void _update_camera();
 };
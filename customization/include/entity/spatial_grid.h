@@ -0,0 +1,97 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "bn_fixed_point.h"
+#include "bn_fixed_rect.h"
+#include "bn_math.h"
+
+// -----------------------------------------------------------------------------
+// Spatial grid
+// -----------------------------------------------------------------------------
+// Broadphase for entity vs entity tests. World space is split in square cells
+// of cell_size pixels, and every item (an index chosen by the owner, e.g. its
+// slot in an enemy list) is stored in the cell holding its center.
+//
+// Cells are hashed into a fixed number of buckets, so rooms of any size use
+// the same memory. Items are kept in intrusive linked lists and update() only
+// relinks the items that changed cell, so refreshing the grid every frame
+// costs little when most entities stay in place.
+//
+// query() visits the items whose center may be inside an area: the area is
+// grown by the largest half size given to update(), so items only need to be
+// stored once no matter how many cells their box touches.
+// -----------------------------------------------------------------------------
+class SpatialGrid
+{
+public:
+    static constexpr int max_items    = 128;
+    static constexpr int cell_shift   = 5;
+    static constexpr int cell_size    = 1 << cell_shift;   // pixels
+    static constexpr int bucket_count = 64;                // power of two
+
+    SpatialGrid();
+
+    // Remove every item
+    void clear();
+
+    // Insert an item, or move it if it is already in the grid
+    void update(int item, const bn::fixed_point& center, bn::fixed half_width, bn::fixed half_height);
+
+    // Remove an item (nothing happens if it is not in the grid)
+    void remove(int item);
+
+    bool contains(int item) const { return _cells[item].stored; }
+
+    // Call func(item) once for every item that may overlap area
+    template<typename Func>
+    void query(const bn::fixed_rect& area, Func&& func) const
+    {
+        const int cell_x0 = (area.left() - _max_half_width).floor_integer() >> cell_shift;
+        const int cell_x1 = (area.right() + _max_half_width).floor_integer() >> cell_shift;
+        const int cell_y0 = (area.top() - _max_half_height).floor_integer() >> cell_shift;
+        const int cell_y1 = (area.bottom() + _max_half_height).floor_integer() >> cell_shift;
+
+        for(int cell_y = cell_y0; cell_y <= cell_y1; ++cell_y)
+        {
+            for(int cell_x = cell_x0; cell_x <= cell_x1; ++cell_x)
+            {
+                for(int item = _heads[_bucket(cell_x, cell_y)]; item >= 0; item = _cells[item].next)
+                {
+                    // Buckets are shared by several cells: skip the other ones
+                    // so no item is reported twice
+                    const Cell& cell = _cells[item];
+
+                    if(cell.x == cell_x && cell.y == cell_y)
+                    {
+                        func(item);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    struct Cell
+    {
+        int16_t x = 0;
+        int16_t y = 0;
+        int16_t prev = -1;
+        int16_t next = -1;
+        bool stored = false;
+    };
+
+    int16_t _heads[bucket_count];
+    Cell _cells[max_items];
+    bn::fixed _max_half_width;
+    bn::fixed _max_half_height;
+
+    static int _bucket(int cell_x, int cell_y)
+    {
+        return (cell_x * 73 + cell_y * 151) & (bucket_count - 1);
+    }
+
+    void _link(int item);
+    void _unlink(int item);
+};
+
+#endif // SPATIAL_GRID_H
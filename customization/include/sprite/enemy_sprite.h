@@ -9,10 +9,12 @@
 
 #include "character_appearance.h"
 #include "entity_sprite.h"
+#include "sprite_render_state.h"
 
 // ---------------------------------------------------------------------------
 // EnemySprite
-// Handles animation for an enemy.
+// Handles animation for an enemy. Only the sprite attributes which changed
+// since the last frame reach butano (SpriteRenderState).
 // ---------------------------------------------------------------------------
 
 class EnemySprite : public EntitySprite
@@ -32,6 +34,7 @@ public:
 
 private:
     bn::optional<bn::sprite_ptr> _sprite;
+    SpriteRenderState _render;
 
     const bn::sprite_item _sprite_item;
 
@@ -30,8 +30,15 @@ public:
 
     void update(const bn::fixed_point& pos, FacingDirection direction, bool moving);
 
+    // Z-orders from depth * depth_z_orders up belong to the entity at that
+    // depth (0 in front, see EntityManager): room for layered sprites, and a
+    // health bar right in front of them
+    static constexpr int depth_z_orders = 8;
+
     virtual bn::fixed_point position() = 0;
     virtual void set_position(bn::fixed_point pos) = 0;
+
+    // z: depth of the entity
     virtual void set_z_order(int z) = 0;
 
     // Trigger special animations
@@ -43,6 +50,9 @@ public:
 
     bool is_locked() const;
 
+    // The death animation reached its end (the entity can be removed)
+    bool death_finished() const { return _death_done; }
+
     virtual void set_visible(bool is_visible) = 0;
 
 protected:
@@ -56,6 +66,7 @@ protected:
     int _attack_frame = 0;   // 0..9    (relative in attack segment)
     int _hurt_frame   = 0;   // 0..3    (relative in hurt segment)
     int _death_frame  = 0;   // 0..3    (relative in death segment)
+    bool _death_done  = false;
 
     bool _moving      = false;
     FacingDirection _direction = FacingDirection::Down;
@@ -3,24 +3,59 @@
 
 #include "bn_fixed_point.h"
 #include "bn_optional.h"
+#include "bn_sprite_palette_ptr.h"
 #include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles_ptr.h"
 #include "bn_camera_ptr.h"
+#include "bn_vector.h"
 
 #include "entity_sprite.h"
+#include "sprite_render_state.h"
 #include "character_appearance.h"
 #include "character_colors.h"
 #include "character_assets.h"
+#include "sprite_compositor.h"
 
 // ---------------------------------------------------------------------------
 // PlayerSprite
 // Handles layered sprites, palettes and animation for a player character.
+//
+// Two render modes:
+// - Layered:    one hardware sprite per layer (body, eyes, bottom, top, hair),
+//               each showing its own sheet frame.
+// - Composited: one hardware sprite showing the layers flattened into its
+//               tiles (sprite_compositor). Flattened frames are cached in VRAM
+//               by frame index, so a frame is only composited again once it
+//               was evicted from the cache.
+//
+// The sheets are 4bpp, sharing 16-color palette banks (generated by
+// tools/character_sheets.py). Layered sprites use one palette per bank; the
+// composited sprite is 8bpp, with the whole character palette layout.
+//
+// Every hardware sprite has a SpriteRenderState, so only the attributes which
+// changed since the last frame reach butano.
 // ---------------------------------------------------------------------------
 
 class PlayerSprite : public EntitySprite
 {
 public:
+    enum class RenderMode
+    {
+        Layered,
+        Composited
+    };
+
+    // Frames kept flattened in VRAM in Composited mode (8bpp: one frame is as
+    // big as two 4bpp layer frames)
+    static constexpr int composite_cache_frames = 4;
+
+    // Layers flattened in Composited mode (body, eyes, bottom, top, hair)
+    static constexpr int composite_layers = 5;
+
     // appearance is a snapshot from customization; it is not modified here
-    explicit PlayerSprite(const CharacterAppearance& appearance);
+    explicit PlayerSprite(const CharacterAppearance& appearance, RenderMode mode = RenderMode::Layered);
+
+    RenderMode render_mode() const { return _mode; }
 
     // Create sprites based on current appearance and initial position
     void rebuild(const bn::fixed_point& pos);
@@ -40,8 +75,20 @@ public:
     void set_visible(bool is_visible) override;
 
 private:
+    // Flattened frame in VRAM
+    struct CompositeFrame
+    {
+        bn::sprite_tiles_ptr tiles;
+        int frame_index;
+        int last_use;
+    };
+
     const CharacterAppearance& _appearance;
-    bn::sprite_palette_ptr _palette;
+    RenderMode _mode;
+
+    // One palette per bank in Layered mode, the 8bpp layout in Composited mode
+    bn::vector<bn::sprite_palette_ptr, k_character_palette_banks> _bank_palettes;
+    bn::optional<bn::sprite_palette_ptr> _palette;
 
     // Layered sprites
     bn::optional<bn::sprite_ptr> _body_sprite;
@@ -57,8 +104,49 @@ private:
     const bn::sprite_item* _bottom_item = nullptr;
     const bn::sprite_item* _hair_item   = nullptr;
 
+    // Composited mode
+    bn::optional<bn::sprite_ptr> _composite_sprite;
+    bn::vector<CompositeFrame, composite_cache_frames> _composite_cache;
+    int _composite_clock = 0;
+
+    // Color tables of the flattened layers, built with the sprites
+    uint16_t _composite_pair_tables[composite_layers][sprite_compositor::pair_table_size];
+
+    // Attributes last applied to each sprite
+    SpriteRenderState _body_render;
+    SpriteRenderState _eyes_render;
+    SpriteRenderState _top_render;
+    SpriteRenderState _bottom_render;
+    SpriteRenderState _hair_render;
+    SpriteRenderState _composite_render;
+
+    // Calls function(sprite, render_state) on every hardware sprite in use
+    template<typename Function>
+    void _for_each_sprite(Function&& function)
+    {
+        bn::optional<bn::sprite_ptr>* sprites[] = {
+            &_body_sprite, &_eyes_sprite, &_top_sprite, &_bottom_sprite, &_hair_sprite, &_composite_sprite
+        };
+
+        SpriteRenderState* render_states[] = {
+            &_body_render, &_eyes_render, &_top_render, &_bottom_render, &_hair_render, &_composite_render
+        };
+
+        for(int index = 0; index < 6; ++index)
+        {
+            if(*sprites[index])
+            {
+                function(**sprites[index], *render_states[index]);
+            }
+        }
+    }
+
     void _rebuild_sprites(const bn::fixed_point& pos);
 
+    // Tiles of a frame with every layer flattened, from the cache or composited
+    // into the least recently used cache entry
+    const bn::sprite_tiles_ptr& _composite_tiles(int frame_index);
+
     void _update_movement_animation(bool moving) override;
     void _update_attack_animation() override;
     void _update_hurt_animation() override;
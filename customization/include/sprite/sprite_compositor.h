@@ -0,0 +1,40 @@
+#ifndef SPRITE_COMPOSITOR_H
+#define SPRITE_COMPOSITOR_H
+
+#include <stdint.h>
+
+#include "bn_common.h"
+#include "bn_tile.h"
+
+// -----------------------------------------------------------------------------
+// Sprite compositor
+// -----------------------------------------------------------------------------
+// Flattens layered sprite frames into the tiles of one sprite, compiled as ARM
+// code in IWRAM (sprite_compositor.bn_iwram.cpp). The color tables of the
+// layers are built once (e.g. when the appearance changes), not per frame.
+//
+// Pixels are handled a word (four 8bpp pixels) at a time and every output word
+// is written once, so the output can be sprite VRAM, which ignores byte writes.
+// -----------------------------------------------------------------------------
+namespace sprite_compositor
+{
+    constexpr int max_layers = 8;
+    constexpr int pair_table_size = 256;
+
+    // Colors of a layer as 8bpp palette indices, two pixels at a time: entry
+    // i is the byte i of 4bpp pixels (left pixel in the low nibble) as two
+    // 8bpp pixels. color_map has 16 entries, 0 only for 0.
+    void build_pair_table(const uint8_t* color_map, uint16_t* pair_table);
+
+    // Draws 4bpp layers[0] to layers[layer_count - 1] on top of each other
+    // into 8bpp output: a non-transparent pixel (color other than 0) of a
+    // layer covers the ones of the layers before it. Colors of layer i become
+    // 8bpp palette indices through pair_tables[i] (see build_pair_table).
+    //
+    // Every layer has tiles_count 4bpp tiles; output gets twice as many
+    // bn::tile (8bpp tiles take two).
+    BN_CODE_IWRAM void composite_4bpp_to_8bpp(const bn::tile* const* layers, const uint16_t* const* pair_tables,
+                                              int layer_count, int tiles_count, bn::tile* output);
+}
+
+#endif // SPRITE_COMPOSITOR_H
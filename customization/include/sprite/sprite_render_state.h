@@ -0,0 +1,131 @@
+#ifndef SPRITE_RENDER_STATE_H
+#define SPRITE_RENDER_STATE_H
+
+#include "bn_camera_ptr.h"
+#include "bn_fixed_point.h"
+#include "bn_optional.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles_item.h"
+
+// -----------------------------------------------------------------------------
+// Sprite render state
+// -----------------------------------------------------------------------------
+// The attributes last applied to one hardware sprite. Each setter compares the
+// new value with the retained one and only forwards it to the sprite when it
+// changed, so syncing an idle entity every frame costs a few compares.
+//
+// Attributes start unknown (their first value is always applied). reset() the
+// state when its sprite is created again, and don't change the sprite
+// attributes it retains without it.
+//
+// Issued and skipped updates are counted for every state together.
+// -----------------------------------------------------------------------------
+class SpriteRenderState
+{
+public:
+    // Every attribute unknown again
+    void reset() { *this = SpriteRenderState(); }
+
+    void set_position(bn::sprite_ptr& sprite, const bn::fixed_point& position)
+    {
+        if(_count(!_position || *_position != position))
+        {
+            _position = position;
+            sprite.set_position(position);
+        }
+    }
+
+    // Retains frame_index, returns true when it changed: the caller then sets
+    // the tiles of that frame
+    bool set_frame(int frame_index)
+    {
+        if(!_count(frame_index != _frame))
+        {
+            return false;
+        }
+
+        _frame = frame_index;
+        return true;
+    }
+
+    // Frame of a tiles item, which stays the same until the state is reset
+    void set_tiles(bn::sprite_ptr& sprite, const bn::sprite_tiles_item& tiles_item, int frame_index)
+    {
+        if(set_frame(frame_index))
+        {
+            sprite.set_tiles(tiles_item, frame_index);
+        }
+    }
+
+    void set_horizontal_flip(bn::sprite_ptr& sprite, bool horizontal_flip)
+    {
+        if(_count(!_horizontal_flip || *_horizontal_flip != horizontal_flip))
+        {
+            _horizontal_flip = horizontal_flip;
+            sprite.set_horizontal_flip(horizontal_flip);
+        }
+    }
+
+    void set_z_order(bn::sprite_ptr& sprite, int z_order)
+    {
+        if(_count(!_z_order || *_z_order != z_order))
+        {
+            _z_order = z_order;
+            sprite.set_z_order(z_order);
+        }
+    }
+
+    void set_visible(bn::sprite_ptr& sprite, bool visible)
+    {
+        if(_count(!_visible || *_visible != visible))
+        {
+            _visible = visible;
+            sprite.set_visible(visible);
+        }
+    }
+
+    // An empty camera removes the sprite camera
+    void set_camera(bn::sprite_ptr& sprite, const bn::optional<bn::camera_ptr>& camera)
+    {
+        if(_count(!_camera_known || _camera != camera))
+        {
+            _camera_known = true;
+            _camera = camera;
+
+            if(camera)
+            {
+                sprite.set_camera(*camera);
+            }
+            else
+            {
+                sprite.remove_camera();
+            }
+        }
+    }
+
+    // Updates forwarded to the sprites and skipped ones since the last
+    // reset_counters()
+    static int issued_updates() { return _issued_updates; }
+    static int skipped_updates() { return _skipped_updates; }
+    static void reset_counters();
+
+private:
+    static int _issued_updates;
+    static int _skipped_updates;
+
+    bn::optional<bn::fixed_point> _position;
+    bn::optional<bn::camera_ptr> _camera;
+    bn::optional<int> _z_order;
+    int _frame = -1;
+    bn::optional<bool> _horizontal_flip;
+    bn::optional<bool> _visible;
+    bool _camera_known = false;
+
+    static bool _count(bool changed)
+    {
+        ++(changed ? _issued_updates : _skipped_updates);
+        return changed;
+    }
+};
+
+#endif // SPRITE_RENDER_STATE_H
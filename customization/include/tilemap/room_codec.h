@@ -0,0 +1,47 @@
+#ifndef ROOM_CODEC_H
+#define ROOM_CODEC_H
+
+#include "bn_regular_bg_map_cell.h"
+
+#include "world_map_data.h"
+
+// -----------------------------------------------------------------------------
+// Room layer decoder
+// -----------------------------------------------------------------------------
+// Expands one layer of a regular (ROOM_WIDTH x ROOM_HEIGHT) metatile room into
+// map cells in screenblock (VRAM) order: the four 32x32 screenblocks top-left,
+// top-right, bottom-left, bottom-right, each one row-major.
+//
+// Output is produced a whole map row (32 cells) at a time. LayerDecoder can
+// stop after any number of rows and resume later, so a layer can be decoded a
+// slice at a time across several frames.
+// -----------------------------------------------------------------------------
+namespace room_codec
+{
+    constexpr int k_row_cells = 32;
+    constexpr int k_row_count = ROOM_CELLS / k_row_cells;
+
+    class LayerDecoder
+    {
+    public:
+        LayerDecoder() = default;
+        LayerDecoder(const RoomMapData& map, int layer, bn::regular_bg_map_cell* cells);
+
+        // Decode at least max_cells more cells (rounded up to whole rows)
+        void decode(int max_cells);
+
+        bool done() const { return _row == _row_count; }
+
+    private:
+        const RoomMapData* _map = nullptr;
+        bn::regular_bg_map_cell* _output = nullptr;
+        int _layer = 0;
+        int _row = 0;
+        int _row_count = 0;
+    };
+
+    // Decode a whole layer in one go
+    void decode_layer(const RoomMapData& map, int layer, bn::regular_bg_map_cell* cells);
+}
+
+#endif // ROOM_CODEC_H
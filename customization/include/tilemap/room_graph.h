@@ -0,0 +1,53 @@
+#ifndef ROOM_GRAPH_H
+#define ROOM_GRAPH_H
+
+#include "bn_fixed_point.h"
+#include "bn_optional.h"
+
+#include "world_map.h"
+#include "world_map_data.h"
+
+// -----------------------------------------------------------------------------
+// Room graph
+// -----------------------------------------------------------------------------
+// Rooms linked by their doors (RoomData::doors), for things that travel between
+// rooms without being simulated (e.g. enemies following the player).
+//
+// Built once: for every door and every room, the walking distance in pixels
+// from going through the door to arriving in that room. Inside a room the
+// distance between two points is the Manhattan distance. Routes are then only
+// table lookups over the doors of one room.
+// -----------------------------------------------------------------------------
+class RoomGraph
+{
+public:
+    static constexpr int max_doors   = ROOM_COUNT * MAX_DOORS_PER_ROOM;
+    static constexpr int unreachable = 0x7FFFFFFF;
+
+    struct Route
+    {
+        int door;           // door of the start room to go through
+        int door_distance;  // pixels from the start position to that door
+        int distance;       // pixels from the start position to the end room
+    };
+
+    RoomGraph();
+
+    // Shortest route from pos in room from to room to (nothing if there is none
+    // or if from is to)
+    bn::optional<Route> route(RoomId from, const bn::fixed_point& pos, RoomId to) const;
+
+    // Pixels from going through a door of from to arriving in to
+    int distance(RoomId from, int door, RoomId to) const;
+
+    // Center of a door (in pixels, room-centered), as placed by WorldMap
+    static bn::fixed_point door_center(RoomId room, int door);
+
+private:
+    int _first_door[ROOM_COUNT];            // index of each room's first door
+    int _distances[max_doors][ROOM_COUNT];
+
+    static bool _valid_door(const DoorData& door) { return door.width_tiles > 0; }
+};
+
+#endif // ROOM_GRAPH_H
@@ -2,16 +2,27 @@
 #define WORLD_MAP_H
 
 #include "bn_fixed_point.h"
+#include "bn_point.h"
+#include "bn_fixed_rect.h"
 #include "bn_optional.h"
 #include "bn_regular_bg_ptr.h"
 #include "bn_camera_ptr.h"
-#include "bn_array.h"
 #include "bn_vector.h"
-#include "bn_regular_bg_map_item.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_timers.h"
 #include "world_map_data.h"
+#include "room_codec.h"
 #include "door.h"
 
 constexpr int MAX_DOORS_PER_ROOM = 8;
+constexpr int MAX_TILE_EDITS     = 256;    // set_tile / set_solid edits kept across all rooms (oldest forgotten first)
+
+// Result of WorldMap::sweep_box
+struct SweepResult
+{
+    bn::fixed_point delta;      // displacement allowed before touching a solid tile
+    bn::point       normal;     // contact normal on each axis (-1, 0 or 1, 0 = no contact)
+};
 
 class WorldMap
 {
@@ -25,56 +36,198 @@ public:
     // Collision query at a world position (in pixels, centered map)
     bool is_solid(const bn::fixed_point& world_pos) const;
 
-    // Map size in pixels (used for camera clamping)
-    int pixel_width() const;
-    int pixel_height() const;
+    // World position (in pixels) -> tile coordinates (may be outside the room)
+    bn::point world_to_tile(const bn::fixed_point& world_pos) const;
+
+    // Tile coordinates -> world position (in pixels) of the tile center
+    bn::fixed_point tile_center(int tx, int ty) const;
+
+    // Attributes (TILE_SOLID, TILE_WATER, ...) of the tile at a world position
+    TileAttributes tile_attributes(const bn::fixed_point& world_pos) const;
+
+    // Tile-level queries. Tiles outside the room count as solid.
+    TileAttributes tile_attributes_at(int tx, int ty) const;
+    bool is_solid_tile(int tx, int ty) const;
+    bool any_solid_in_row(int ty) const;
+    bool any_solid_in_span(int ty, int tx0, int tx1) const;   // tiles [tx0, tx1] of row ty
+    bool any_solid_in_column(int tx, int ty0, int ty1) const; // tiles [ty0, ty1] of column tx
+
+    // Move a box (world pixels) by delta, X axis first and then Y, only
+    // testing the tiles it enters. Returns how far it can move and which walls
+    // it touched, so movers stop flush against them and slide along them.
+    SweepResult sweep_box(const bn::fixed_rect& box, const bn::fixed_point& delta) const;
+
+    // Size of the current room in pixels (used for camera clamping)
+    int pixel_width() const { return _map->width * TILE_SIZE; }
+    int pixel_height() const { return _map->height * TILE_SIZE; }
 
     // Current room
     RoomId current_room() const { return _current_room; }
 
-    // Change to another room
+    // Changes whenever the collision of the current room does (room change,
+    // set_solid), so cached collision data knows when to rebuild
+    int collision_revision() const { return _collision_revision; }
+
+    // Change to another room at once
     void change_room(RoomId room);
 
-    // Per-frame update
+    // Incremental room change, spread over several frames (e.g. a fade):
+    // - begin_room_load starts building a room without touching the visible one
+    // - update_room_load decodes fixed-size chunks until budget_ticks is used up,
+    //   and returns true once the room is ready
+    // - commit_room_load finishes any remaining work and swaps the room in
+    //
+    // Budgets are bn::timer ticks, not CPU cycles.
+    static constexpr int room_load_budget_ticks = bn::timers::ticks_per_frame() / 4;   // a quarter of a frame
+
+    void begin_room_load(RoomId room);
+    bool update_room_load(int budget_ticks = room_load_budget_ticks);
+    void commit_room_load();
+
+    bool room_load_pending() const { return _pending_load.has_value(); }
+
+    // Background prefetch of the rooms behind the current room's doors, so
+    // walking through a door only swaps cached cells in. Call it once per
+    // frame; it decodes for budget_ticks at most (a fixed share of the frame
+    // by default, not whatever time the game logic left).
+    static constexpr int prefetch_budget_ticks = bn::timers::ticks_per_frame() / 8;    // an eighth of a frame
+
+    void update_prefetch(int budget_ticks = prefetch_budget_ticks);
+
+    // Change tiles of the current room (breakable walls, switches, ...). Edits
+    // are kept per room, so they are still there when the room is entered
+    // again. Cell changes are batched and only the changed range is copied to
+    // VRAM by the next update().
+    //
+    // Edits back to the room data free their entry. Past MAX_TILE_EDITS, the
+    // oldest edit of another room is forgotten (or else the oldest one of this
+    // room), and its tile shows the room data again.
+    // - layer: 0 = layer 1 (bottom), 1 = layer 2 (top)
+    // - tile: tile index in the room tileset (as in the map cells)
+    void set_tile(int layer, int tx, int ty, int tile);
+    void set_solid(int tx, int ty, bool solid);
+
+    // Per-frame update (doors, tile edits, and the cell ring of streamed rooms)
     void update();
 
+#ifdef WORLD_MAP_STREAM_CHECK
+    // Debug check of a streamed room: every cell of the ring holds the tile
+    // (and tile edits) it stands for. Always true for regular rooms. Built
+    // with -DWORLD_MAP_STREAM_CHECK only (the host build defines it).
+    bool stream_matches_room() const;
+#endif
+
     bn::optional<DoorTarget> check_door_collision(const bn::fixed_point& player_pos) const;
 
 private:
+    // Map cells of a regular room, expanded from its metatiles
     struct BgLayer
     {
         alignas(int) bn::regular_bg_map_cell cells[ROOM_CELLS];
-        bn::regular_bg_map_item map_item;
+    };
 
-        BgLayer() :
-            map_item(cells[0], bn::size(ROOM_WIDTH, ROOM_HEIGHT))
-        {
-        }
+    // Cache of decoded regular rooms (allocated with the WorldMap, in EWRAM):
+    // the visible room plus rooms decoded ahead of time behind its doors
+    struct RoomSlot
+    {
+        BgLayer layers[2];
+        room_codec::LayerDecoder decoders[2];
+        bn::optional<RoomId> room;      // room held or being decoded
+
+        bool decoded() const { return decoders[0].done() && decoders[1].done(); }
     };
 
-    // Visible layers:
-    BgLayer _layer1_map;
-    BgLayer _layer2_map;
+    static constexpr int room_cache_slots = 3;
+
+    RoomSlot _slots[room_cache_slots];
+    int _front_slot = -1;               // slot shown by the backgrounds (-1 = streamed room)
 
+    // Backgrounds and their maps, allocated in VRAM and written directly:
+    // - regular rooms copy their cache slot in (and then only the edited cells)
+    // - streamed rooms keep a STREAM_SIZE x STREAM_SIZE ring of cells, tile
+    //   (x, y) lives in cell (x % STREAM_SIZE, y % STREAM_SIZE) and the
+    //   background wraps around it as the camera moves
     bn::optional<bn::regular_bg_ptr> _layer1_bg;
     bn::optional<bn::regular_bg_ptr> _layer2_bg;
+    bn::optional<bn::regular_bg_map_ptr> _layer_maps[2];
+
+    bn::point _stream_origin;       // top-left tile held in the ring
+    bool _stream_valid = false;
 
-    // Collision layer (0 = empty, non-zero = solid)
-    bn::array<bool, ROOM_CELLS> _collision_cells;
+    // Size and metatiles of the current room (read straight from ROM)
+    const RoomMapData* _map = nullptr;
 
     // Doors for the current room
     bn::vector<Door, MAX_DOORS_PER_ROOM> _doors;
 
     // Which room is currently loaded
     RoomId _current_room;
+    int _collision_revision = 0;
 
     // Camera (optional)
     bn::optional<bn::camera_ptr> _camera;
 
+    // Room being built by the incremental loader
+    struct RoomLoad
+    {
+        RoomId room = RoomId::MainRoom;
+        int slot    = -1;               // -1 for streamed rooms (nothing to decode)
+        bool cached = false;            // already decoded by the prefetcher
+        int ticks   = 0;
+        int frames  = 0;
+    };
+
+    static constexpr int room_load_chunk_cells = 256;
+
+    bn::optional<RoomLoad> _pending_load;
+
+    // Tile edits of every room, in the order they were made
+    struct TileEdit
+    {
+        RoomId   room;
+        uint16_t tx;
+        uint16_t ty;
+        uint8_t  layer;         // 0 / 1: map cell of layer 1 / 2, attributes_edit_layer: attributes
+        uint16_t value;         // map cell or tile attributes
+    };
+
+    static constexpr int attributes_edit_layer = 2;
+
+    bn::vector<TileEdit, MAX_TILE_EDITS> _edits;
+
+    // Attribute edits of the current room, sorted by tile for the queries
+    struct AttributeEdit
+    {
+        int            tile;    // ty * room width + tx
+        TileAttributes attributes;
+    };
+
+    bn::vector<AttributeEdit, MAX_TILE_EDITS> _attribute_edits;
+
+    // Range of edited cells of the front slot not copied to VRAM yet, per layer
+    int _dirty_begin[2] = { ROOM_CELLS, ROOM_CELLS };
+    int _dirty_end[2]   = { 0, 0 };
+
     // -------------------------------------------------------
     // Internal helpers
-    void _build_room(RoomId room);
-    void _fill_layer(const uint8_t* source, BgLayer& layer);
+    int _find_slot(RoomId room) const;
+    int _claim_slot(RoomId room, bool evict_door_targets);
+    bool _is_door_target(RoomId room) const;
+    static int _decode_slot(RoomSlot& slot, int budget_ticks);
+    void _apply_edits();
+    void _record_edit(int layer, int tx, int ty, int value);
+    int _room_value(RoomId room, int layer, int tx, int ty) const;
+    void _forget_edit(int index);
+    void _show_cell(int layer, int tx, int ty, bn::regular_bg_map_cell cell);
+    void _forget_oldest_edit();
+    int _attribute_edit_index(int tile) const;
+    void _set_attribute_edit(int tile, TileAttributes attributes);
+    void _remove_attribute_edit(int tile);
+    void _flush_edits();
+    void _update_stream();
+    void _stream_row(int ty);
+    void _stream_column(int tx);
+    void _stream_edits(int tx0, int ty0, int tx1, int ty1);
 };
 
 #endif // WORLD_MAP_H
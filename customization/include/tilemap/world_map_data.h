@@ -4,13 +4,36 @@
 #include <stdint.h>
 
 // -----------------------------------------------------------------------------
-// Shared constants: each room is 64x64 tiles of size 8x8
+// Shared constants: tiles are 8x8, regular rooms are 64x64 tiles
 // -----------------------------------------------------------------------------
 constexpr int TILE_SIZE   = 8;
 constexpr int ROOM_WIDTH  = 64;
 constexpr int ROOM_HEIGHT = 64;
 constexpr int ROOM_CELLS  = ROOM_WIDTH * ROOM_HEIGHT;
 
+// Rooms of any other size (multiples of STREAM_SIZE, e.g. 256x256) are
+// streamed: only a STREAM_SIZE x STREAM_SIZE ring of cells around the camera
+// is kept in RAM/VRAM.
+constexpr int STREAM_SIZE  = 32;
+constexpr int STREAM_CELLS = STREAM_SIZE * STREAM_SIZE;
+
+// Rooms are made of METATILE_SIZE x METATILE_SIZE blocks of tiles (metatiles)
+constexpr int METATILE_SIZE = 2;
+
+static_assert(STREAM_SIZE % METATILE_SIZE == 0, "Rooms must be a whole number of metatiles");
+
+// -----------------------------------------------------------------------------
+// Tile attributes (see rooms/tile_attributes.json)
+// -----------------------------------------------------------------------------
+using TileAttributes = uint8_t;
+
+constexpr TileAttributes TILE_SOLID        = 1 << 0;
+constexpr TileAttributes TILE_ONE_WAY      = 1 << 1;
+constexpr TileAttributes TILE_WATER        = 1 << 2;
+constexpr TileAttributes TILE_SLOW         = 1 << 3;
+constexpr TileAttributes TILE_HURT         = 1 << 4;
+constexpr TileAttributes TILE_DOOR_TRIGGER = 1 << 5;
+
 // -----------------------------------------------------------------------------
 // Room IDs
 // -----------------------------------------------------------------------------
@@ -43,9 +66,9 @@ struct DoorData
     // Door rectangle in TILE coordinates within this room:
     // - tile_x / tile_y are the LEFTMOST tile and row of the door
     // - width_tiles is how many tiles wide (you said 4)
-    uint8_t tile_x;       // 0..63
-    uint8_t tile_y;       // 0..63
-    uint8_t width_tiles;  // typically 4
+    uint16_t tile_x;      // 0..room width - 1
+    uint16_t tile_y;      // 0..room height - 1
+    uint8_t  width_tiles; // typically 4
 
     // Which room this door leads to
     RoomId target_room;
@@ -56,152 +79,141 @@ struct DoorData
     int16_t target_y_px;
 };
 
+// -----------------------------------------------------------------------------
+// Enemy spawn points (pure data, enemies are created on room entry)
+// -----------------------------------------------------------------------------
+struct SpawnData
+{
+    // Spawn position (in PIXELS, room-centered)
+    int16_t x_px;
+    int16_t y_px;
+};
+
+// -----------------------------------------------------------------------------
+// Metatiles
+// -----------------------------------------------------------------------------
+// Rooms are generated by tools/room_builder.py from rooms/roomN.json as one
+// byte per metatile, indexing a dictionary shared by all rooms. A metatile
+// holds ready-to-use bn::regular_bg_map_cell values for both layers and the
+// attributes of its four tiles, so a room is expanded on load by copying cells
+// and collision is looked up through the same byte.
+//
+// Tile attributes are resolved at build time from the tileset attribute table
+// (layer 1 tile | layer 2 tile) plus the room's sparse overrides.
+//
+// Quadrant order inside a metatile: 0 top-left, 1 top-right, 2 bottom-left,
+// 3 bottom-right, i.e. (y % 2) * 2 + (x % 2).
+struct Metatile
+{
+    uint16_t       cells[2][4];     // [layer][quadrant]: 0 = layer 1 (bottom), 1 = layer 2 (top)
+    TileAttributes attributes[4];   // [quadrant]
+};
+
 // -----------------------------------------------------------------------------
 // Per-room tile/collision/door data
 // -----------------------------------------------------------------------------
+struct RoomMapData
+{
+    uint16_t width;                 // in tiles
+    uint16_t height;                // in tiles
+    const Metatile* dictionary;
+    const uint8_t* metatiles;       // (width / 2) * (height / 2) dictionary indices, row-major
+
+    bool streamed() const
+    {
+        return width != ROOM_WIDTH || height != ROOM_HEIGHT;
+    }
+
+    const Metatile& metatile_at(int tx, int ty) const
+    {
+        return dictionary[metatiles[(ty / METATILE_SIZE) * (width / METATILE_SIZE) + tx / METATILE_SIZE]];
+    }
+};
+
 struct RoomData
 {
-    const uint8_t* layer1;      // bottom
-    const uint8_t* layer2;      // top
-    const bool* collision;      // 0 = empty, non-zero = solid
+    const RoomMapData* map;         // generated from rooms/roomN.json
 
     // Doors defined for this room:
     const DoorData* doors;
     int             door_count;
+
+    // Enemies spawned when the room is entered (may be null):
+    const SpawnData* spawns;
+    int              spawn_count;
 };
 
 // Expose the list of rooms:
 extern const RoomData g_rooms[ROOM_COUNT];
 
 // -----------------------------------------------------------------------------
-// Example room arrays (you’ll define them in world_map_data.cpp)
+// Door arrays (defined in world_map_data.cpp)
 // -----------------------------------------------------------------------------
 
 // Room 0 (MainRoom)
-extern const uint8_t room0_layer1[ROOM_CELLS];
-extern const uint8_t room0_layer2[ROOM_CELLS];
-extern const bool    room0_collision[ROOM_CELLS];
-
 extern const DoorData room0_doors[];
 extern const int      room0_door_count;
 
-// Room 1 (Hallway)
-extern const uint8_t room1_layer1[ROOM_CELLS];
-extern const uint8_t room1_layer2[ROOM_CELLS];
-extern const bool    room1_collision[ROOM_CELLS];
+extern const SpawnData room0_spawns[];
+extern const int       room0_spawn_count;
 
+// Room 1 (Hallway)
 extern const DoorData room1_doors[];
 extern const int      room1_door_count;
 
 // Room 2
-extern const uint8_t room2_layer1[ROOM_CELLS];
-extern const uint8_t room2_layer2[ROOM_CELLS];
-extern const bool    room2_collision[ROOM_CELLS];
-
 extern const DoorData room2_doors[];
 extern const int      room2_door_count;
 
 // Room 3
-extern const uint8_t room3_layer1[ROOM_CELLS];
-extern const uint8_t room3_layer2[ROOM_CELLS];
-extern const bool    room3_collision[ROOM_CELLS];
-
 extern const DoorData room3_doors[];
 extern const int      room3_door_count;
 
 // Room 4
-extern const uint8_t room4_layer1[ROOM_CELLS];
-extern const uint8_t room4_layer2[ROOM_CELLS];
-extern const bool    room4_collision[ROOM_CELLS];
-
 extern const DoorData room4_doors[];
 extern const int      room4_door_count;
 
 // Room 5
-extern const uint8_t room5_layer1[ROOM_CELLS];
-extern const uint8_t room5_layer2[ROOM_CELLS];
-extern const bool    room5_collision[ROOM_CELLS];
-
 extern const DoorData room5_doors[];
 extern const int      room5_door_count;
 
 // Room 6
-extern const uint8_t room6_layer1[ROOM_CELLS];
-extern const uint8_t room6_layer2[ROOM_CELLS];
-extern const bool    room6_collision[ROOM_CELLS];
-
 extern const DoorData room6_doors[];
 extern const int      room6_door_count;
 
 // Room 7
-extern const uint8_t room7_layer1[ROOM_CELLS];
-extern const uint8_t room7_layer2[ROOM_CELLS];
-extern const bool    room7_collision[ROOM_CELLS];
-
 extern const DoorData room7_doors[];
 extern const int      room7_door_count;
 
 // Room 8
-extern const uint8_t room8_layer1[ROOM_CELLS];
-extern const uint8_t room8_layer2[ROOM_CELLS];
-extern const bool    room8_collision[ROOM_CELLS];
-
 extern const DoorData room8_doors[];
 extern const int      room8_door_count;
 
 // Room 9
-extern const uint8_t room9_layer1[ROOM_CELLS];
-extern const uint8_t room9_layer2[ROOM_CELLS];
-extern const bool    room9_collision[ROOM_CELLS];
-
 extern const DoorData room9_doors[];
 extern const int      room9_door_count;
 
 // Room 10
-extern const uint8_t room10_layer1[ROOM_CELLS];
-extern const uint8_t room10_layer2[ROOM_CELLS];
-extern const bool    room10_collision[ROOM_CELLS];
-
 extern const DoorData room10_doors[];
 extern const int      room10_door_count;
 
 // Room 11
-extern const uint8_t room11_layer1[ROOM_CELLS];
-extern const uint8_t room11_layer2[ROOM_CELLS];
-extern const bool    room11_collision[ROOM_CELLS];
-
 extern const DoorData room11_doors[];
 extern const int      room11_door_count;
 
 // Room 12
-extern const uint8_t room12_layer1[ROOM_CELLS];
-extern const uint8_t room12_layer2[ROOM_CELLS];
-extern const bool    room12_collision[ROOM_CELLS];
-
 extern const DoorData room12_doors[];
 extern const int      room12_door_count;
 
 // Room 13
-extern const uint8_t room13_layer1[ROOM_CELLS];
-extern const uint8_t room13_layer2[ROOM_CELLS];
-extern const bool    room13_collision[ROOM_CELLS];
-
 extern const DoorData room13_doors[];
 extern const int      room13_door_count;
 
 // Room 14
-extern const uint8_t room14_layer1[ROOM_CELLS];
-extern const uint8_t room14_layer2[ROOM_CELLS];
-extern const bool    room14_collision[ROOM_CELLS];
-
 extern const DoorData room14_doors[];
 extern const int      room14_door_count;
 
 // Room 15
-extern const uint8_t room15_layer1[ROOM_CELLS];
-extern const uint8_t room15_layer2[ROOM_CELLS];
-extern const bool    room15_collision[ROOM_CELLS];
-
 extern const DoorData room15_doors[];
 extern const int      room15_door_count;
 
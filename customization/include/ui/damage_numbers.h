@@ -32,6 +32,7 @@ private:
     static bn::sprite_text_generator* _text_gen;
     static bn::camera_ptr* _camera;
     static bn::vector<Entry, 16> _entries;
+    static int _spawn_count;
 };
 
 #endif // DAMAGE_NUMBERS_H
@@ -0,0 +1,88 @@
+#ifndef PROFILER_OVERLAY_H
+#define PROFILER_OVERLAY_H
+
+#include <stdint.h>
+
+#include "bn_sprite_text_generator.h"
+#include "bn_sprite_ptr.h"
+#include "bn_string.h"
+#include "bn_vector.h"
+#include "bn_timers.h"
+
+#include "frame_scheduler.h"
+
+// -----------------------------------------------------------------------------
+// Profiler overlay
+// -----------------------------------------------------------------------------
+// Min, average and max timer ticks per frame over windows of window_frames
+// frames, for every frame phase of a FrameScheduler (timed by the scheduler)
+// plus named scopes timed outside it (e.g. bn::core::update).
+//
+// L + R + SELECT toggles it. While it is shown, the phases and scopes are
+// drawn as sprite text, with their share of the frame (lines which don't fit
+// in the hardware sprites left are skipped), and each window is also streamed
+// through BN_LOG per scheduler system.
+// -----------------------------------------------------------------------------
+class ProfilerOverlay
+{
+public:
+    static constexpr int window_frames = 64;
+    static constexpr int max_scopes    = 4;
+    static constexpr int frame_ticks   = bn::timers::ticks_per_frame();
+
+    // The generator is only used by the overlay (its alignment is changed)
+    explicit ProfilerOverlay(bn::sprite_text_generator& text_generator);
+
+    // Scope timed outside the scheduler, returns its id
+    int add_scope(const char* name);
+
+    // Timer ticks a scope used this frame
+    void record(int scope, int ticks);
+
+    // Once per frame, after every scope was recorded: adds the scheduler
+    // ticks of the last frame and handles the toggle
+    void update(const FrameScheduler& scheduler);
+
+    bool visible() const { return _visible; }
+
+private:
+    // Min / sum / max over the current window, and the last complete window
+    struct Stats
+    {
+        int min = INT32_MAX;
+        int max = 0;
+        int64_t sum = 0;
+
+        int shown_min = 0;
+        int shown_average = 0;
+        int shown_max = 0;
+
+        void add(int ticks);
+        void close_window();
+    };
+
+    struct Scope
+    {
+        const char* name;
+        int ticks;
+        Stats stats;
+    };
+
+    bn::sprite_text_generator& _text_generator;
+    bn::vector<bn::sprite_ptr, 64> _sprites;
+
+    Stats _phases[FRAME_PHASE_COUNT];
+    Stats _systems[FrameScheduler::max_systems];
+    bn::vector<Scope, max_scopes> _scopes;
+    Stats _frame;
+
+    int _window_frame = 0;
+    bool _visible = false;
+
+    void _close_window(const FrameScheduler& scheduler);
+    void _log(const FrameScheduler& scheduler) const;
+    void _redraw();
+    void _draw_text(int y, const bn::string<48>& text);
+};
+
+#endif // PROFILER_OVERLAY_H
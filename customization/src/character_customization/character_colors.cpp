@@ -172,14 +172,19 @@ void FeatureColorRamp::apply_ramp_to_palette(bn::sprite_palette_ptr& pal) const
 //  7-10     hair color
 // 11-12     top color
 // 13-15     pants color
+// 16-31     fixed colors of the sheets (outlines, highlights, ...)
+//
+// The sheets are converted to 4bpp at build time (tools/character_sheets.py)
+// and their colors packed into 16-color banks, which map every bank slot back
+// to an index of this layout.
 // ---------------------------------------------------------------------------
 
-void update_palette(
-    bn::sprite_palette_ptr& pal,
-    BodyColor    body_color, 
-    FeatureColor eyes_color, 
-    FeatureColor hair_color, 
-    FeatureColor top_color, 
+void character_ramp_colors(
+    bn::color    colors[k_character_ramp_colors],
+    BodyColor    body_color,
+    FeatureColor eyes_color,
+    FeatureColor hair_color,
+    FeatureColor top_color,
     FeatureColor bottom_color)
 {
     // Get ramps
@@ -189,28 +194,70 @@ void update_palette(
     const FeatureColorRamp& top_ramp    = get_feature_ramp(top_color);
     const FeatureColorRamp& bottom_ramp = get_feature_ramp(bottom_color);
 
+    colors[0] = bn::color();
+
     // 1-4: skin color
-    pal.set_color(1, skin_ramp.c0);
-    pal.set_color(2, skin_ramp.c1);
-    pal.set_color(3, skin_ramp.c2);
-    pal.set_color(4, skin_ramp.c3);
+    colors[1] = skin_ramp.c0;
+    colors[2] = skin_ramp.c1;
+    colors[3] = skin_ramp.c2;
+    colors[4] = skin_ramp.c3;
 
     // 5-6: eye color
-    pal.set_color(5, eye_ramp.c1);
-    pal.set_color(6, eye_ramp.c4);
+    colors[5] = eye_ramp.c1;
+    colors[6] = eye_ramp.c4;
 
     // 7-10: hair color
-    pal.set_color(7, hair_ramp.c0);
-    pal.set_color(8, hair_ramp.c2);
-    pal.set_color(9, hair_ramp.c5);
-    pal.set_color(10, hair_ramp.c6);
+    colors[7] = hair_ramp.c0;
+    colors[8] = hair_ramp.c2;
+    colors[9] = hair_ramp.c5;
+    colors[10] = hair_ramp.c6;
 
     // 11-12: top color
-    pal.set_color(11, top_ramp.c2);
-    pal.set_color(12, top_ramp.c5);
+    colors[11] = top_ramp.c2;
+    colors[12] = top_ramp.c5;
 
     // 13-15: bottom color
-    pal.set_color(13, bottom_ramp.c1);
-    pal.set_color(14, bottom_ramp.c3);
-    pal.set_color(15, bottom_ramp.c4);
+    colors[13] = bottom_ramp.c1;
+    colors[14] = bottom_ramp.c3;
+    colors[15] = bottom_ramp.c4;
+}
+
+void update_palette(
+    bn::sprite_palette_ptr& pal,
+    BodyColor    body_color, 
+    FeatureColor eyes_color, 
+    FeatureColor hair_color, 
+    FeatureColor top_color, 
+    FeatureColor bottom_color)
+{
+    bn::color colors[k_character_ramp_colors];
+    character_ramp_colors(colors, body_color, eyes_color, hair_color, top_color, bottom_color);
+
+    for(int index = 1; index < k_character_ramp_colors; ++index)
+    {
+        pal.set_color(index, colors[index]);
+    }
+}
+
+void update_palette_bank(
+    bn::sprite_palette_ptr& pal,
+    const uint8_t*          bank_colors,
+    BodyColor               body_color,
+    FeatureColor            eyes_color,
+    FeatureColor            hair_color,
+    FeatureColor            top_color,
+    FeatureColor            bottom_color)
+{
+    bn::color colors[k_character_ramp_colors];
+    character_ramp_colors(colors, body_color, eyes_color, hair_color, top_color, bottom_color);
+
+    for(int slot = 1; slot < k_character_bank_size; ++slot)
+    {
+        const int index = bank_colors[slot];
+
+        if(index && index < k_character_ramp_colors)
+        {
+            pal.set_color(slot, colors[index]);
+        }
+    }
 }
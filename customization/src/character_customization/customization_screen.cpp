@@ -1,8 +1,7 @@
 #include "customization_screen.h"
 #include "character_colors.h"
 #include "character_assets.h"
-
-#include "bn_keypad.h"
+#include "game_input.h"
 
 CustomizationScreen::CustomizationScreen() :
     _preview(bn::fixed_point(-80, 7), _model.appearance())
@@ -26,12 +25,12 @@ void CustomizationScreen::_handle_input()
     bool ui_needs_refresh = false;
 
     // Bumpers switch tabs
-    if(bn::keypad::l_pressed())
+    if(GameInput::pressed(bn::keypad::key_type::L))
     {
         _menu.move_tab(-1);
         ui_needs_refresh = true;
     }
-    else if(bn::keypad::r_pressed())
+    else if(GameInput::pressed(bn::keypad::key_type::R))
     {
         _menu.move_tab(1);
         ui_needs_refresh = true;
@@ -59,34 +58,34 @@ void CustomizationScreen::_handle_input()
     };
 
     // D-pad moves selection in the current tab grid
-    if(bn::keypad::left_pressed())
+    if(GameInput::pressed(bn::keypad::key_type::LEFT))
     {
         handle_move(0, -1);
     }
-    else if(bn::keypad::right_pressed())
+    else if(GameInput::pressed(bn::keypad::key_type::RIGHT))
     {
         handle_move(0, 1);
     }
-    else if(bn::keypad::up_pressed())
+    else if(GameInput::pressed(bn::keypad::key_type::UP))
     {
         handle_move(-1, 0);
     }
-    else if(bn::keypad::down_pressed())
+    else if(GameInput::pressed(bn::keypad::key_type::DOWN))
     {
         handle_move(1, 0);
     }
 
     // Rotate character with A and B
-    if(bn::keypad::a_pressed())
+    if(GameInput::pressed(bn::keypad::key_type::A))
     {
         _rotate_character(1);
-    } else if(bn::keypad::b_pressed())
+    } else if(GameInput::pressed(bn::keypad::key_type::B))
     {
         _rotate_character(-1);
     }
 
     // Toggle animation with select
-    if(bn::keypad::select_pressed())
+    if(GameInput::pressed(bn::keypad::key_type::SELECT))
     {
         _preview.toggle_animation();
     }
@@ -96,7 +95,7 @@ void CustomizationScreen::_handle_input()
         _refresh_ui();
     }
 
-    if(bn::keypad::start_pressed())
+    if(GameInput::pressed(bn::keypad::key_type::START))
     {
         _done = true;
     }
@@ -0,0 +1,185 @@
+#include "benchmark.h"
+
+#include "bn_assert.h"
+#include "bn_core.h"
+#include "bn_keypad.h"
+#include "bn_log.h"
+#include "bn_string_view.h"
+
+#include "game_input.h"
+
+Benchmark::Scenario Benchmark::_scenario = Benchmark::Scenario::None;
+const char* Benchmark::_name = nullptr;
+Benchmark::Phase Benchmark::_phases[max_phases] = {};
+int Benchmark::_phase_count = 0;
+bn::optional<bn::timer> Benchmark::_timer;
+int Benchmark::_frame = 0;
+int64_t Benchmark::_work_sum = 0;
+int Benchmark::_work_max = 0;
+int Benchmark::_frames_over_budget = 0;
+
+namespace
+{
+    using key_type = bn::keypad::key_type;
+
+    struct ScenarioName
+    {
+        const char* name;
+        Benchmark::Scenario scenario;
+    };
+
+    constexpr ScenarioName k_scenarios[] = {
+        { "chase", Benchmark::Scenario::Chase },
+        { "doors", Benchmark::Scenario::Doors },
+        { "menu", Benchmark::Scenario::MenuSpam },
+    };
+
+    // Chase: walk a square with the enemies behind, attacking at the corners
+    constexpr int k_chase_side_frames = 48;
+
+    constexpr int k_chase_sides[] = {
+        int(key_type::RIGHT), int(key_type::DOWN), int(key_type::LEFT), int(key_type::UP)
+    };
+
+    // Menu: every key the customization screen reads, except START (done)
+    constexpr int k_menu_keys[] = {
+        int(key_type::RIGHT), int(key_type::DOWN), int(key_type::A), int(key_type::R),
+        int(key_type::LEFT), int(key_type::UP), int(key_type::B), int(key_type::SELECT),
+        int(key_type::DOWN), int(key_type::RIGHT), int(key_type::L),
+    };
+
+    constexpr int k_menu_key_count = int(sizeof(k_menu_keys) / sizeof(k_menu_keys[0]));
+}
+
+void Benchmark::initialize(const char* name)
+{
+    for(const ScenarioName& entry : k_scenarios)
+    {
+        if(bn::string_view(entry.name) == name)
+        {
+            _scenario = entry.scenario;
+            _name = entry.name;
+        }
+    }
+
+    BN_ASSERT(active(), "Unknown benchmark scenario: ", name);
+
+    GameInput::initialize_script(&_keys);
+    _timer = bn::timer();
+    BN_LOG("bench begin ", _name, ' ', frames);
+}
+
+void Benchmark::record(const char* phase, int ticks)
+{
+    if(!active())
+    {
+        return;
+    }
+
+    for(int index = 0; index < _phase_count; ++index)
+    {
+        if(_phases[index].name == phase)
+        {
+            _phases[index].ticks += ticks;
+            return;
+        }
+    }
+
+    BN_ASSERT(_phase_count < max_phases, "Too many benchmark phases: ", phase);
+
+    _phases[_phase_count] = Phase{ phase, ticks, 0, 0, 0 };
+    ++_phase_count;
+}
+
+void Benchmark::record(const FrameScheduler& scheduler)
+{
+    for(int phase = 0; phase < FRAME_PHASE_COUNT; ++phase)
+    {
+        record(frame_phase_name(static_cast<FramePhase>(phase)),
+               scheduler.phase_ticks(static_cast<FramePhase>(phase)));
+    }
+}
+
+void Benchmark::frame_ended()
+{
+    if(!active())
+    {
+        return;
+    }
+
+    const int work = _timer->elapsed_ticks();
+    _work_sum += work;
+    _work_max = work > _work_max ? work : _work_max;
+    _frames_over_budget += work > frame_ticks;
+
+    // Phases are only averaged over the frames they ran in (e.g. no gameplay
+    // phases during a fade)
+    for(int index = 0; index < _phase_count; ++index)
+    {
+        Phase& phase = _phases[index];
+
+        if(phase.ticks)
+        {
+            ++phase.frames;
+            phase.sum += phase.ticks;
+            phase.max = phase.ticks > phase.max ? phase.ticks : phase.max;
+            phase.ticks = 0;
+        }
+    }
+
+    if(++_frame == frames)
+    {
+        _report();
+    }
+}
+
+void Benchmark::frame_started()
+{
+    if(active())
+    {
+        _timer->restart();
+    }
+}
+
+int Benchmark::_keys(int frame)
+{
+    switch(_scenario)
+    {
+        case Scenario::Chase:
+        {
+            const int side = (frame / k_chase_side_frames) % 4;
+            const bool attack = frame % k_chase_side_frames == 0;
+            return k_chase_sides[side] | (attack ? int(key_type::A) : 0);
+        }
+
+        case Scenario::MenuSpam:
+            // Released every other frame, so each key is a new press
+            return frame % 2 ? 0 : k_menu_keys[(frame / 2) % k_menu_key_count];
+
+        default:
+            return 0;
+    }
+}
+
+void Benchmark::_report()
+{
+    // One short line each: the mGBA debug log can't take a whole JSON object
+    BN_LOG("bench frames ", _frame, " over_budget ", _frames_over_budget,
+           " average ", int(_work_sum / _frame), " max ", _work_max);
+
+    for(int index = 0; index < _phase_count; ++index)
+    {
+        const Phase& phase = _phases[index];
+        const int average = phase.frames ? int(phase.sum / phase.frames) : 0;
+
+        BN_LOG("bench phase ", phase.name, " frames ", phase.frames, " average ", average, " max ", phase.max);
+    }
+
+    BN_LOG("bench end ", _name);
+
+    // The runner stops the emulator once it reads the end line
+    while(true)
+    {
+        bn::core::update();
+    }
+}
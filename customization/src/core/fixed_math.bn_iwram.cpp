@@ -0,0 +1,204 @@
+#include "fixed_math.h"
+
+#include <stdint.h>
+
+#include "bn_assert.h"
+
+// Tables are not const so they are copied to IWRAM with the code (const data
+// stays in ROM, which is slower to read)
+namespace
+{
+    // sin(i / 256 turn) for a quarter turn, Q12
+    int16_t sin_table[65] = {
+        0, 101, 201, 301, 401, 501, 601, 700, 799, 897, 995, 1092,
+        1189, 1285, 1380, 1474, 1567, 1660, 1751, 1842, 1931, 2019, 2106, 2191,
+        2276, 2359, 2440, 2520, 2598, 2675, 2751, 2824, 2896, 2967, 3035, 3102,
+        3166, 3229, 3290, 3349, 3406, 3461, 3513, 3564, 3612, 3659, 3703, 3745,
+        3784, 3822, 3857, 3889, 3920, 3948, 3973, 3996, 4017, 4036, 4052, 4065,
+        4076, 4085, 4091, 4095, 4096,
+    };
+
+    // atan(i / 64) in binary angle units
+    uint16_t atan_table[65] = {
+        0, 163, 326, 489, 651, 813, 975, 1136, 1297, 1457, 1617, 1775,
+        1933, 2090, 2246, 2401, 2555, 2708, 2860, 3010, 3159, 3307, 3453, 3599,
+        3742, 3884, 4025, 4164, 4302, 4438, 4572, 4705, 4836, 4966, 5094, 5220,
+        5344, 5467, 5589, 5708, 5826, 5943, 6058, 6171, 6282, 6392, 6500, 6607,
+        6712, 6815, 6917, 7018, 7117, 7214, 7310, 7405, 7498, 7589, 7679, 7768,
+        7856, 7942, 8026, 8110, 8192,
+    };
+
+    // 1 / sqrt(t) for t in [0.25, 1] in 1 / 256 steps, Q14. Index = top 8 bits
+    // of a 16 bit mantissa, minus 64.
+    uint16_t rsqrt_table[193] = {
+        32768, 32515, 32268, 32026, 31790, 31558, 31332, 31111, 30894, 30682, 30474, 30270,
+        30070, 29874, 29682, 29494, 29309, 29127, 28949, 28774, 28602, 28434, 28268, 28105,
+        27945, 27787, 27632, 27480, 27330, 27183, 27038, 26895, 26755, 26617, 26481, 26346,
+        26214, 26084, 25956, 25830, 25705, 25583, 25462, 25342, 25225, 25109, 24994, 24882,
+        24770, 24660, 24552, 24445, 24339, 24235, 24132, 24031, 23930, 23831, 23733, 23637,
+        23541, 23447, 23354, 23262, 23170, 23080, 22992, 22904, 22817, 22731, 22646, 22562,
+        22479, 22396, 22315, 22235, 22155, 22077, 21999, 21922, 21845, 21770, 21695, 21621,
+        21548, 21476, 21404, 21333, 21263, 21193, 21124, 21056, 20988, 20921, 20855, 20789,
+        20724, 20660, 20596, 20533, 20470, 20408, 20346, 20285, 20225, 20165, 20106, 20047,
+        19988, 19930, 19873, 19816, 19760, 19704, 19649, 19594, 19539, 19485, 19431, 19378,
+        19326, 19273, 19221, 19170, 19119, 19068, 19018, 18968, 18919, 18870, 18821, 18773,
+        18725, 18677, 18630, 18583, 18536, 18490, 18444, 18399, 18354, 18309, 18264, 18220,
+        18176, 18133, 18090, 18047, 18004, 17962, 17920, 17878, 17837, 17795, 17755, 17714,
+        17674, 17634, 17594, 17554, 17515, 17476, 17438, 17399, 17361, 17323, 17285, 17248,
+        17211, 17174, 17137, 17100, 17064, 17028, 16992, 16957, 16921, 16886, 16851, 16817,
+        16782, 16748, 16714, 16680, 16646, 16613, 16579, 16546, 16514, 16481, 16448, 16416,
+        16384,
+    };
+
+    constexpr int fraction_bits = bn::fixed::precision();
+
+    int64_t shift_right(int64_t value, int shift)
+    {
+        return shift >= 0 ? value >> shift : value << -shift;
+    }
+
+    // 1 / sqrt(value / 2^value_fraction_bits) = table value / 2^(14 + exponent)
+    int rsqrt_mantissa(uint64_t value, int value_fraction_bits, int& exponent)
+    {
+        // Shift the value into [2^14, 2^16) by an amount with the parity of
+        // value_fraction_bits, so the square root of the scale is a power of two
+        const int top_bit = 63 - __builtin_clzll(value);
+        int shift = top_bit - 15;
+
+        if((shift - value_fraction_bits) & 1)
+        {
+            ++shift;
+        }
+
+        const int mantissa = int(shift >= 0 ? value >> shift : value << -shift);
+        exponent = (16 + shift - value_fraction_bits) / 2;
+        const int index = (mantissa >> 8) - 64;
+        const int result = rsqrt_table[index];
+        return result + (((rsqrt_table[index + 1] - result) * (mantissa & 255)) >> 8);
+    }
+}
+
+namespace fixed_math
+{
+    bn::fixed rsqrt(bn::fixed value)
+    {
+        BN_ASSERT(value > 0, "Invalid value: ", value);
+
+        int exponent;
+        const int mantissa = rsqrt_mantissa(uint64_t(value.data()), fraction_bits, exponent);
+        return bn::fixed::from_data(int(shift_right(mantissa, 14 + exponent - fraction_bits)));
+    }
+
+    bn::fixed_point normalize(const bn::fixed_point& vector)
+    {
+        const int64_t x = vector.x().data();
+        const int64_t y = vector.y().data();
+        const uint64_t length_squared = uint64_t(x * x + y * y);
+
+        if(!length_squared)
+        {
+            return bn::fixed_point();
+        }
+
+        int exponent;
+        const int mantissa = rsqrt_mantissa(length_squared, fraction_bits * 2, exponent);
+        const int shift = 14 + exponent;
+
+        return bn::fixed_point(bn::fixed::from_data(int(shift_right(x * mantissa, shift))),
+                               bn::fixed::from_data(int(shift_right(y * mantissa, shift))));
+    }
+
+    bn::fixed sin(int angle)
+    {
+        angle &= k_turn - 1;
+
+        // Mirror the second and fourth quarters onto the first one
+        const int quarter = angle >> 14;
+        int position = angle & (k_turn / 4 - 1);
+
+        if(quarter & 1)
+        {
+            position = k_turn / 4 - position;
+        }
+
+        const int index = position >> 8;
+        int value = sin_table[index];
+
+        if(index < 64)
+        {
+            value += ((sin_table[index + 1] - value) * (position & 255)) >> 8;
+        }
+
+        return bn::fixed::from_data(quarter & 2 ? -value : value);
+    }
+
+    bn::fixed cos(int angle)
+    {
+        return sin(angle + k_turn / 4);
+    }
+
+    int atan2(bn::fixed y, bn::fixed x)
+    {
+        const int64_t abs_x = x < 0 ? -int64_t(x.data()) : x.data();
+        const int64_t abs_y = y < 0 ? -int64_t(y.data()) : y.data();
+
+        if(!abs_x && !abs_y)
+        {
+            return 0;
+        }
+
+        // Ratio of the smallest to the biggest component (0 .. 1, Q12), with
+        // 1 / biggest taken from the reciprocal square root of its square
+        const int64_t biggest  = abs_x >= abs_y ? abs_x : abs_y;
+        const int64_t smallest = abs_x >= abs_y ? abs_y : abs_x;
+
+        int exponent;
+        const int mantissa = rsqrt_mantissa(uint64_t(biggest * biggest), fraction_bits * 2, exponent);
+        const int ratio = int(shift_right(smallest * mantissa, 14 + exponent));
+
+        int angle;
+
+        if(ratio >= (1 << fraction_bits))
+        {
+            angle = k_turn / 8;
+        }
+        else
+        {
+            const int index = ratio >> 6;
+            angle = atan_table[index] + (((atan_table[index + 1] - atan_table[index]) * (ratio & 63)) >> 6);
+        }
+
+        // First octant -> whole turn
+        if(abs_y > abs_x)
+        {
+            angle = k_turn / 4 - angle;
+        }
+
+        if(x < 0)
+        {
+            angle = k_turn / 2 - angle;
+        }
+
+        if(y < 0)
+        {
+            angle = k_turn - angle;
+        }
+
+        return angle & (k_turn - 1);
+    }
+
+    bn::fixed_point unit_vector(int angle)
+    {
+        return bn::fixed_point(cos(angle), sin(angle));
+    }
+
+    int quantize_direction(const bn::fixed_point& vector, int directions)
+    {
+        BN_ASSERT(directions > 0 && directions <= 256 && !(directions & (directions - 1)),
+                  "Invalid direction count: ", directions);
+
+        const int step = k_turn / directions;
+        const int angle = atan2(vector.y(), vector.x());
+        return ((angle + step / 2) & (k_turn - 1)) / step;
+    }
+}
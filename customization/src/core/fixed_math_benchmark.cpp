@@ -0,0 +1,110 @@
+#include "fixed_math_benchmark.h"
+
+#include "bn_log.h"
+#include "bn_math.h"
+#include "bn_timer.h"
+#include "bn_timers.h"
+
+#include "fixed_math.h"
+
+namespace
+{
+    constexpr int k_calls = 256;
+
+    // A timer tick is 64 CPU cycles, longer than some of the calls timed, so
+    // cycles are worked out from the ticks of all the calls
+    constexpr int64_t k_cpu_cycles_per_second = 16777216;
+
+    // Results are summed here so the calls are not optimized out
+    volatile int sink;
+
+    // Inputs: vectors of many directions, from 2 to 512 pixels long (the same
+    // input cost is included on both sides)
+    bn::fixed_point vector_input(int index)
+    {
+        const bn::fixed length = bn::fixed(index + 1) * 2;
+        const bn::fixed_point unit = fixed_math::unit_vector(index * (fixed_math::k_turn / k_calls) * 7);
+        return bn::fixed_point(unit.x() * length, unit.y() * length);
+    }
+
+    template<typename Func>
+    int cycles_per_call(Func&& func)
+    {
+        int sum = 0;
+        bn::timer timer;
+
+        for(int index = 0; index < k_calls; ++index)
+        {
+            sum += func(index);
+        }
+
+        const int64_t ticks = timer.elapsed_ticks();
+        sink = sum;
+        return int(ticks * k_cpu_cycles_per_second / (int64_t(bn::timers::ticks_per_second()) * k_calls));
+    }
+
+    template<typename Func, typename ReferenceFunc>
+    void compare(const char* name, Func&& func, ReferenceFunc&& reference)
+    {
+        const int cycles = cycles_per_call(func);
+        const int reference_cycles = cycles_per_call(reference);
+
+        BN_LOG(name, ": ", cycles, " cycles per call, bn:: ", reference_cycles, " cycles per call");
+    }
+}
+
+void run_fixed_math_benchmark()
+{
+    compare("rsqrt", [](int index)
+    {
+        return fixed_math::rsqrt(bn::fixed(index + 1)).data();
+    },
+    [](int index)
+    {
+        return (1 / bn::sqrt(bn::fixed(index + 1))).data();
+    });
+
+    compare("normalize", [](int index)
+    {
+        const bn::fixed_point unit = fixed_math::normalize(vector_input(index));
+        return unit.x().data() + unit.y().data();
+    },
+    [](int index)
+    {
+        const bn::fixed_point vector = vector_input(index);
+        const bn::fixed length = bn::sqrt(vector.x() * vector.x() + vector.y() * vector.y());
+        return (vector.x() / length).data() + (vector.y() / length).data();
+    });
+
+    compare("sin", [](int index)
+    {
+        return fixed_math::sin(index * (fixed_math::k_turn / k_calls)).data();
+    },
+    [](int index)
+    {
+        return bn::sin(bn::fixed::from_data(index * (4096 / k_calls))).data();
+    });
+
+    compare("atan2", [](int index)
+    {
+        const bn::fixed_point vector = vector_input(index);
+        return fixed_math::atan2(vector.y(), vector.x());
+    },
+    [](int index)
+    {
+        const bn::fixed_point vector = vector_input(index);
+        return bn::atan2(vector.y().data(), vector.x().data()).data();
+    });
+
+    compare("quantize_direction(16)", [](int index)
+    {
+        return fixed_math::quantize_direction(vector_input(index), 16);
+    },
+    [](int index)
+    {
+        // bn::atan2 is in [-0.5, 0.5] turns
+        const bn::fixed_point vector = vector_input(index);
+        const bn::fixed turns = bn::atan2(vector.y().data(), vector.x().data());
+        return (turns * 16 + bn::fixed(0.5)).floor_integer() & 15;
+    });
+}
@@ -0,0 +1,70 @@
+#include "frame_scheduler.h"
+
+#include "bn_assert.h"
+#include "bn_timer.h"
+
+const char* frame_phase_name(FramePhase phase)
+{
+    constexpr const char* names[FRAME_PHASE_COUNT] = {
+        "input", "ai", "move", "combat", "anim", "render", "ui"
+    };
+
+    return names[static_cast<int>(phase)];
+}
+
+int FrameScheduler::add(FramePhase phase, const char* name, system_function function, void* context)
+{
+    BN_ASSERT(function, "Null frame system: ", name);
+    BN_ASSERT(!_running, "Frame systems can't be added while a frame runs: ", name);
+    BN_ASSERT(!_systems.full(), "Too many frame systems: ", name);
+
+    for(const System& system : _systems)
+    {
+        BN_ASSERT(system.function != function || system.context != context,
+                  "Frame system registered twice: ", name);
+    }
+
+    const int id = _systems.size();
+    _systems.push_back(System{ function, context, name, phase, 0 });
+
+    // Insert after the last system of the same or an earlier phase
+    auto position = _run_order.end();
+    while(position != _run_order.begin() && _systems[*(position - 1)].phase > phase)
+    {
+        --position;
+    }
+
+    _run_order.insert(position, id);
+    return id;
+}
+
+void FrameScheduler::run_frame()
+{
+    BN_ASSERT(!_running, "Nested frame");
+    _running = true;
+
+    for(int& ticks : _phase_ticks)
+    {
+        ticks = 0;
+    }
+
+    // One timer for the whole frame; each system is charged the ticks since
+    // the previous one finished
+    bn::timer frame_timer;
+    int elapsed_ticks = 0;
+
+    for(int id : _run_order)
+    {
+        System& system = _systems[id];
+        system.function(system.context);
+
+        const int now_ticks = frame_timer.elapsed_ticks();
+        system.ticks = now_ticks - elapsed_ticks;
+        elapsed_ticks = now_ticks;
+
+        _phase_ticks[static_cast<int>(system.phase)] += system.ticks;
+    }
+
+    _frame_ticks = elapsed_ticks;
+    _running = false;
+}
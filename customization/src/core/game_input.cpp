@@ -0,0 +1,235 @@
+#include "game_input.h"
+
+#include "bn_assert.h"
+#include "bn_log.h"
+#include "bn_sram.h"
+
+GameInput::Mode GameInput::_mode = GameInput::Mode::Live;
+GameInput::key_script GameInput::_script = nullptr;
+int GameInput::_frame = 0;
+int GameInput::_keys = 0;
+int GameInput::_previous_keys = 0;
+GameInput::Header GameInput::_header = {};
+GameInput::Run GameInput::_run = {};
+int GameInput::_run_index = 0;
+int GameInput::_run_frames_left = 0;
+uint32_t GameInput::_checksum = GameInput::checksum_seed;
+int GameInput::_checksum_frames = 0;
+bool GameInput::_replay_matches = true;
+
+namespace
+{
+    constexpr uint32_t k_magic = 0x31504E49;    // "INP1"
+
+    constexpr bn::keypad::key_type k_keys[] = {
+        bn::keypad::key_type::A, bn::keypad::key_type::B,
+        bn::keypad::key_type::SELECT, bn::keypad::key_type::START,
+        bn::keypad::key_type::RIGHT, bn::keypad::key_type::LEFT,
+        bn::keypad::key_type::UP, bn::keypad::key_type::DOWN,
+        bn::keypad::key_type::R, bn::keypad::key_type::L,
+    };
+
+    // SRAM layout: header, runs, checkpoints
+    constexpr int k_runs_offset        = 16;
+    constexpr int k_checkpoints_offset = k_runs_offset + GameInput::max_runs * 4;
+
+    static_assert(k_checkpoints_offset + GameInput::max_checkpoints * 4 <= 32 * 1024,
+                  "Recorded sessions don't fit in SRAM");
+}
+
+void GameInput::initialize(Mode mode)
+{
+    _mode = mode;
+    _frame = 0;
+    _keys = 0;
+    _previous_keys = 0;
+    _run = Run{ 0, 0 };
+    _run_index = 0;
+    _run_frames_left = 0;
+    _checksum = checksum_seed;
+    _checksum_frames = 0;
+    _replay_matches = true;
+
+    if(mode == Mode::Record)
+    {
+        // Overwrite the header right away, so a stale session can't be replayed
+        // against a partial recording
+        _header = Header{ k_magic, 0, 0, 0 };
+        bn::sram::write(_header);
+    }
+    else if(mode == Mode::Replay)
+    {
+        bn::sram::read(_header);
+
+        if(_header.magic != k_magic || !_header.runs)
+        {
+            BN_LOG("No recorded input session, replay disabled");
+            _mode = Mode::Live;
+        }
+        else
+        {
+            BN_LOG("Replaying ", _header.frames, " frames (", _header.runs, " runs, ",
+                   _header.checkpoints, " checkpoints)");
+        }
+    }
+}
+
+void GameInput::initialize_script(key_script script)
+{
+    BN_ASSERT(script, "Null key script");
+
+    initialize(Mode::Live);
+    _mode = Mode::Script;
+    _script = script;
+}
+
+void GameInput::update()
+{
+    _previous_keys = _keys;
+
+    if(_mode == Mode::Replay)
+    {
+        _keys = _replay();
+    }
+    else if(_mode == Mode::Script)
+    {
+        _keys = _script(_frame);
+    }
+    else
+    {
+        _keys = _read_keypad();
+
+        if(_mode == Mode::Record)
+        {
+            _record(_keys);
+        }
+    }
+
+    ++_frame;
+}
+
+void GameInput::add_checksum(uint32_t checksum)
+{
+    _checksum = GameInput::checksum(_checksum, int(checksum));
+    ++_checksum_frames;
+
+    if(_checksum_frames % checkpoint_frames)
+    {
+        return;
+    }
+
+    const int checkpoint = _checksum_frames / checkpoint_frames - 1;
+    const int offset = k_checkpoints_offset + checkpoint * int(sizeof(uint32_t));
+
+    if(_mode == Mode::Record)
+    {
+        if(checkpoint < max_checkpoints)
+        {
+            bn::sram::write_offset(_checksum, offset);
+            _header.checkpoints = uint16_t(checkpoint + 1);
+            _save();
+        }
+    }
+    else if(_mode == Mode::Replay && checkpoint < _header.checkpoints)
+    {
+        uint32_t recorded;
+        bn::sram::read_offset(recorded, offset);
+
+        if(recorded != _checksum && _replay_matches)
+        {
+            BN_LOG("Replay diverged between gameplay frames ", checkpoint * checkpoint_frames,
+                   " and ", _checksum_frames);
+            _replay_matches = false;
+        }
+    }
+}
+
+int GameInput::_read_keypad()
+{
+    int keys = 0;
+
+    for(bn::keypad::key_type key : k_keys)
+    {
+        if(bn::keypad::held(key))
+        {
+            keys |= int(key);
+        }
+    }
+
+    return keys;
+}
+
+void GameInput::_record(int keys)
+{
+    // Close the open run when the keys change
+    if(_run.frames && (keys != _run.keys || _run.frames == UINT16_MAX))
+    {
+        bn::sram::write_offset(_run, k_runs_offset + _header.runs * int(sizeof(Run)));
+        ++_header.runs;
+        _run.frames = 0;
+
+        if(_header.runs == max_runs)
+        {
+            BN_LOG("Input recording full after ", _header.frames, " frames");
+            bn::sram::write(_header);
+            _mode = Mode::Live;
+            return;
+        }
+    }
+
+    if(!_run.frames)
+    {
+        _run.keys = uint16_t(keys);
+    }
+
+    ++_run.frames;
+    ++_header.frames;
+}
+
+int GameInput::_replay()
+{
+    if(!_run_frames_left)
+    {
+        if(_run_index == _header.runs)
+        {
+            _finish_replay();
+            return _read_keypad();
+        }
+
+        bn::sram::read_offset(_run, k_runs_offset + _run_index * int(sizeof(Run)));
+        _run_frames_left = _run.frames;
+        ++_run_index;
+    }
+
+    --_run_frames_left;
+    return _run.keys;
+}
+
+void GameInput::_save()
+{
+    // The open run is saved in the slot it will be closed into, and counted
+    // until then
+    Header header = _header;
+
+    if(_run.frames)
+    {
+        bn::sram::write_offset(_run, k_runs_offset + _header.runs * int(sizeof(Run)));
+        ++header.runs;
+    }
+
+    bn::sram::write(header);
+}
+
+void GameInput::_finish_replay()
+{
+    if(_replay_matches)
+    {
+        BN_LOG("Replay finished, ", _header.checkpoints, " checkpoints match");
+    }
+    else
+    {
+        BN_LOG("Replay finished, state diverged from the recording");
+    }
+
+    _mode = Mode::Live;
+}
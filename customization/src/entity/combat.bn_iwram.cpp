@@ -0,0 +1,6 @@
+#include "hot_code.h"
+
+// ARM code in IWRAM when HOTCODE has this set (see combat.cpp)
+#if HOT_CODE_COMBAT
+    #include "combat.inc"
+#endif
@@ -0,0 +1,6 @@
+#include "hot_code.h"
+
+// Thumb code in ROM, unless HOTCODE has this set (see combat.bn_iwram.cpp)
+#if !HOT_CODE_COMBAT
+    #include "combat.inc"
+#endif
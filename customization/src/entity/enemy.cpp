@@ -2,7 +2,8 @@
 
 #include "bn_math.h"
 #include "world_map.h"
-#include "bn_log.h"
+#include "flow_field.h"
+#include "fixed_math.h"
 
 namespace
 {
@@ -12,7 +13,7 @@ namespace
 
 Enemy::Enemy(EntitySprite* sprite, const WorldMap* world_map) :
     Entity(
-        sprite, world_map, 5, 1, Hitbox(0, 0, 6, 6), Hitbox(0, 0, 6, 6)
+        sprite, world_map, 5, 1, Hitbox(0, 0, hurt_half_width, 6), Hitbox(0, 0, 6, 6)
     ),
     _direction(FacingDirection::Down),
     _velocity(ZERO_VELOCITY),
@@ -20,8 +21,7 @@ Enemy::Enemy(EntitySprite* sprite, const WorldMap* world_map) :
     _aggro_radius(64),
     _lose_radius(128),
     _attack_cooldown(0),
-    _attack_cooldown_max(60),
-    _path_recalc_timer(0)
+    _attack_cooldown_max(60)
 {
 }
 
@@ -31,12 +31,32 @@ void Enemy::attach_camera(const bn::camera_ptr& camera)
     Entity::attach_camera(camera);
 }
 
-void Enemy::update()
+void Enemy::update_movement()
 {
-    _update_ai();
-    _apply_movement_animation();
+    _apply_movement();
 
-    update_entity();
+    Entity::update_movement();
+}
+
+bool Enemy::is_pursuing() const
+{
+    if(!is_alive() || !_target || !_target->is_alive())
+    {
+        return false;
+    }
+
+    const bn::fixed_point my_pos     = position();
+    const bn::fixed_point target_pos = _target->position();
+    const bn::fixed dx = bn::abs(target_pos.x() - my_pos.x());
+    const bn::fixed dy = bn::abs(target_pos.y() - my_pos.y());
+
+    // Per axis first, so the squares can't overflow
+    if(dx >= _lose_radius || dy >= _lose_radius)
+    {
+        return false;
+    }
+
+    return dx * dx + dy * dy < _lose_radius * _lose_radius;
 }
 
 bn::fixed_point Enemy::_get_feet_position(const bn::fixed_point& old_pos, const bn::fixed_point& new_pos) const {
@@ -50,7 +70,7 @@ bn::fixed_point Enemy::_get_feet_position(const bn::fixed_point& old_pos, const
     return feet_pos;
 }
 
-void Enemy::_update_ai()
+void Enemy::update_ai()
 {
     _start_attack = false;
 
@@ -72,11 +92,20 @@ void Enemy::_update_ai()
         target_pos.y() - my_pos.y()
     );
 
-    const bn::fixed dx       = to_target.x();
-    const bn::fixed dy       = to_target.y();
-    const bn::fixed dist_sq  = dx * dx + dy * dy;
-    const bn::fixed aggro_sq = _aggro_radius * _aggro_radius;
-    const bn::fixed lose_sq  = _lose_radius  * _lose_radius;
+    const bn::fixed dx = bn::abs(to_target.x());
+    const bn::fixed dy = bn::abs(to_target.y());
+
+    // Per axis first: in large rooms the squares would overflow bn::fixed
+    // (20.12, past ~724 px)
+    bool in_aggro = false;
+    bool too_far  = dx >= _lose_radius || dy >= _lose_radius;
+
+    if(!too_far)
+    {
+        const bn::fixed dist_sq = dx * dx + dy * dy;
+        in_aggro = dist_sq <= _aggro_radius * _aggro_radius;
+        too_far  = dist_sq >= _lose_radius * _lose_radius;
+    }
 
     // Try to attack if in range and off cooldown
     if(!_sprite->is_locked() && _attack_cooldown <= 0 && attack_hits(*_target))
@@ -88,11 +117,11 @@ void Enemy::_update_ai()
     }
 
     // Movement logic based on distance
-    if(dist_sq <= aggro_sq)
+    if(in_aggro)
     {
         _update_path_and_velocity(my_pos, target_pos);
     }
-    else if(dist_sq >= lose_sq)
+    else if(too_far)
     {
         // Too far; forget and stop moving
         _velocity = ZERO_VELOCITY;
@@ -105,148 +134,73 @@ void Enemy::_update_ai()
 }
 
 // -----------------------------------------------------------------------------
-// Simple local "pathfinding"
+// Pathfinding
 // -----------------------------------------------------------------------------
-// Instead of just going straight toward the player, we test the 4 cardinal
-// directions a small step ahead, skip blocked ones, and pick the one that
-// gets us closest to the player. This lets enemies slide around simple
-// obstacles while staying cheap for the GBA.
+// Steer the feet toward the center of the neighbouring tile one step closer to
+// the target in the shared flow field, so enemies walk around walls. Next to
+// the target, or where the field has nothing (not built yet, no path, outside
+// its window), chase the target in a straight line.
 // -----------------------------------------------------------------------------
 void Enemy::_update_path_and_velocity(const bn::fixed_point& my_pos,
                                       const bn::fixed_point& target_pos)
 {
-    // If we don't have a world map, just fall back to the old direct chase.
-    if(!_world_map)
-    {
-        _chase(bn::fixed_point(
-            target_pos.x() - my_pos.x(),
-            target_pos.y() - my_pos.y()
-        ));
-        return;
-    }
-
-    if(_path_recalc_timer > 0)
+    if(_world_map && _flow_field)
     {
-        --_path_recalc_timer;
-        // Keep current velocity for now.
-        return;
-    }
-
-    _path_recalc_timer = k_path_recalc_interval;
-
-    // Candidate directions: stand still, left, right, up, down
-    // (no diagonals to keep speed consistent and code simple).
-    constexpr int DIR_COUNT = 5;
-    const bn::fixed_point directions[DIR_COUNT] = {
-        bn::fixed_point(0,  0),   // stay still
-        bn::fixed_point(1,  0),   // right
-        bn::fixed_point(-1, 0),   // left
-        bn::fixed_point(0,  1),   // down
-        bn::fixed_point(0, -1)    // up
-    };
+        const bn::fixed_point feet_pos = feet_position();
+        const bn::point tile = _world_map->world_to_tile(feet_pos);
 
-    constexpr bn::fixed step = 8;     // "look" 8 pixels ahead
-
-    bn::fixed       best_dist_sq = bn::fixed(32767);
-    bn::fixed_point best_dir(0, 0);
-
-    for(int i = 1; i < DIR_COUNT; ++i)   // skip index 0 (stand still) as candidate
-    {
-        const bn::fixed_point dir = directions[i];
-
-        bn::fixed_point candidate_pos(
-            my_pos.x() + dir.x() * step,
-            my_pos.y() + dir.y() * step
-        );
-
-        if(!_can_stand_at(my_pos, candidate_pos))
+        if(bn::optional<bn::point> next = _flow_field->next_tile(tile))
         {
-            continue;
-        }
-
-        const bn::fixed cdx = target_pos.x() - candidate_pos.x();
-        const bn::fixed cdy = target_pos.y() - candidate_pos.y();
-        const bn::fixed d2  = cdx * cdx + cdy * cdy;
-
-        if(d2 < best_dist_sq)
-        {
-            BN_LOG(d2, best_dist_sq);
-            best_dist_sq = d2;
-            best_dir     = dir;
+            const bn::fixed_point next_pos = _world_map->tile_center(next->x(), next->y());
+            _chase(bn::fixed_point(next_pos.x() - feet_pos.x(), next_pos.y() - feet_pos.y()));
+            return;
         }
     }
 
-    _velocity.set_x(best_dir.x() * _max_speed);
-    _velocity.set_y(best_dir.y() * _max_speed);
+    _chase(bn::fixed_point(
+        target_pos.x() - my_pos.x(),
+        target_pos.y() - my_pos.y()
+    ));
 }
 
-// Fallback: straight-line chase (used only if no world_map).
+// Straight-line chase
 void Enemy::_chase(const bn::fixed_point& to_target)
 {
-    const bn::fixed tx = to_target.x();
-    const bn::fixed ty = to_target.y();
-
-    if(tx == 0 && ty == 0)
+    if(to_target.x() == 0 && to_target.y() == 0)
     {
         _velocity = ZERO_VELOCITY;
         return;
     }
 
-    // Normalize using max component (same as your original code).
-    const bn::fixed abs_x    = bn::abs(tx);
-    const bn::fixed abs_y    = bn::abs(ty);
-    const bn::fixed max_comp = bn::max(abs_x, abs_y);
-
-    if(max_comp <= 0)
-    {
-        _velocity = ZERO_VELOCITY;
-        return;
-    }
+    const bn::fixed_point direction = fixed_math::normalize(to_target);
 
-    const bn::fixed nx = tx / max_comp;
-    const bn::fixed ny = ty / max_comp;
-
-    _velocity.set_x(nx * _max_speed);
-    _velocity.set_y(ny * _max_speed);
+    _velocity.set_x(direction.x() * _max_speed);
+    _velocity.set_y(direction.y() * _max_speed);
 }
 
 // -----------------------------------------------------------------------------
-// Movement + animation (now with collisions)
+// Movement (with collisions)
 // -----------------------------------------------------------------------------
-void Enemy::_apply_movement_animation()
+void Enemy::_apply_movement()
 {
     bn::fixed_point new_pos = position();
 
-    // Apply axis-separated movement with collision checks (same pattern as Player).
+    // Swept movement against the map (same pattern as Player)
     if(_world_map)
     {
-        // X axis
-        if(_velocity.x() != 0)
+        if(_velocity.x() != 0 || _velocity.y() != 0)
         {
-            bn::fixed_point test = new_pos;
-            test.set_x(test.x() + _velocity.x());
+            const SweepResult sweep = _sweep(new_pos, _velocity);
+            new_pos.set_x(new_pos.x() + sweep.delta.x());
+            new_pos.set_y(new_pos.y() + sweep.delta.y());
 
-            if(_can_stand_at(new_pos, test))
-            {
-                new_pos.set_x(test.x());
-            }
-            else
+            // Stop along the axes that hit a wall
+            if(sweep.normal.x() != 0)
             {
                 _velocity.set_x(0);
             }
-        }
 
-        // Y axis
-        if(_velocity.y() != 0)
-        {
-            bn::fixed_point test = new_pos;
-            test.set_y(test.y() + _velocity.y());
-
-            if(_can_stand_at(new_pos, test))
-            {
-                new_pos.set_y(test.y());
-            }
-            else
+            if(sweep.normal.y() != 0)
             {
                 _velocity.set_y(0);
             }
@@ -259,6 +213,14 @@ void Enemy::_apply_movement_animation()
         new_pos.set_y(new_pos.y() + _velocity.y());
     }
 
+    _sprite->set_position(new_pos);
+}
+
+// -----------------------------------------------------------------------------
+// Animation
+// -----------------------------------------------------------------------------
+void Enemy::update_animation()
+{
     const bool moving =
         bn::abs(_velocity.x()) > STOP_THRESHOLD ||
         bn::abs(_velocity.y()) > STOP_THRESHOLD;
@@ -286,7 +248,5 @@ void Enemy::_apply_movement_animation()
         }
     }
 
-    // This assumes your sprite.update() stores the new position internally so that
-    // Entity::position() keeps in sync, just like your Player does.
-    _sprite->update(new_pos, _direction, moving);
+    _sprite->update(position(), _direction, moving);
 }
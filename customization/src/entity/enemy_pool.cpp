@@ -0,0 +1,47 @@
+#include "enemy_pool.h"
+
+#include "bn_assert.h"
+#include "bn_sprites.h"
+
+EnemyPool::EnemyPool()
+{
+    // Hand out low slots first
+    for(int slot = capacity - 1; slot >= 0; --slot)
+    {
+        _free_slots.push_back(slot);
+    }
+}
+
+Enemy* EnemyPool::acquire(const bn::fixed_point& pos, const WorldMap* world_map)
+{
+    if(_free_slots.empty() || bn::sprites::available_items_count() < sprites_per_enemy + reserved_sprites)
+    {
+        return nullptr;
+    }
+
+    Slot& slot = _slots[_free_slots.back()];
+    _free_slots.pop_back();
+
+    slot.sprite.emplace(pos);
+    slot.enemy.emplace(&*slot.sprite, world_map);
+    return &*slot.enemy;
+}
+
+void EnemyPool::release(Enemy* enemy)
+{
+    for(int index = 0; index < capacity; ++index)
+    {
+        Slot& slot = _slots[index];
+
+        if(slot.enemy && &*slot.enemy == enemy)
+        {
+            // Enemy first: it points to the sprite
+            slot.enemy.reset();
+            slot.sprite.reset();
+            _free_slots.push_back(index);
+            return;
+        }
+    }
+
+    BN_ERROR("Enemy not in pool");
+}
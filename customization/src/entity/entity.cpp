@@ -1,5 +1,6 @@
 #include "entity.h"
 #include "world_map.h"
+#include "fixed_math.h"
 
 Entity::Entity(EntitySprite* sprite,
                const WorldMap* world_map,
@@ -59,24 +60,20 @@ bn::fixed_point Entity::_clamp_to_world(const bn::fixed_point& candidate) const
     return bn::fixed_point(clamped_x, clamped_y);
 }
 
-bool Entity::_can_stand_at(const bn::fixed_point& old_pos, const bn::fixed_point& new_pos) const
+bn::fixed_rect Entity::_feet_box(const bn::fixed_point& pos) const
 {
-    if(!_world_map)
-    {
-        return true;
-    }
-
-    bn::fixed_point feet_center = _get_feet_position(old_pos, new_pos);
-
-    bn::fixed_point feet_left  = feet_center;
-    bn::fixed_point feet_right = feet_center;
+    // Feet probes sit higher when moving up than when moving down: cover
+    // both rows, one pixel tall each
+    const bn::fixed top    = _get_feet_position(bn::fixed_point(pos.x(), pos.y() + 1), pos).y();
+    const bn::fixed bottom = _get_feet_position(pos, pos).y() + 1;
+    const bn::fixed height = bottom - top;
 
-    feet_left.set_x(feet_left.x() - _hurt_box.half_width);
-    feet_right.set_x(feet_right.x() + _hurt_box.half_width - 1);
+    return bn::fixed_rect(pos.x(), top + height / 2, _hurt_box.half_width * 2, height);
+}
 
-    return !_world_map->is_solid(feet_center) &&
-           !_world_map->is_solid(feet_left)   &&
-           !_world_map->is_solid(feet_right);
+SweepResult Entity::_sweep(const bn::fixed_point& pos, const bn::fixed_point& delta) const
+{
+    return _world_map->sweep_box(_feet_box(pos), delta);
 }
 
 void Entity::move_by(const bn::fixed_point& delta)
@@ -86,31 +83,11 @@ void Entity::move_by(const bn::fixed_point& delta)
         return;
     }
 
-    bn::fixed_point new_pos = _sprite->position();
-
-    // X axis
-    if(delta.x() != 0)
-    {
-        bn::fixed_point test = new_pos;
-        test.set_x(test.x() + delta.x());
-
-        if(_can_stand_at(new_pos, test))
-        {
-            new_pos.set_x(test.x());
-        }
-    }
-
-    // Y axis
-    if(delta.y() != 0)
-    {
-        bn::fixed_point test = new_pos;
-        test.set_y(test.y() + delta.y());
+    const bn::fixed_point pos = _sprite->position();
 
-        if(_can_stand_at(new_pos, test))
-        {
-            new_pos.set_y(test.y());
-        }
-    }
+    // Slide flush against walls instead of rejecting the whole step
+    const SweepResult sweep = _sweep(pos, delta);
+    bn::fixed_point new_pos(pos.x() + sweep.delta.x(), pos.y() + sweep.delta.y());
 
     // Clamp to map bounds so we never leave the world
     new_pos = _clamp_to_world(new_pos);
@@ -123,23 +100,32 @@ void Entity::attach_camera(const bn::camera_ptr& camera)
     _health_bar.attach_camera(camera);
 }
 
-void Entity::update_entity()
+void Entity::update_movement()
 {
     _apply_knockback();
+}
 
+void Entity::set_depth(int depth)
+{
+    _depth = depth;
+
+    if(_sprite)
+    {
+        _sprite->set_z_order(depth);
+    }
+}
+
+void Entity::sync_render()
+{
     if(_sprite)
     {
-        // Y-sort: bigger Y = closer to camera (on top)
+        // Depth is set by the Y-sort of EntityManager
         if(is_alive())
         {
-            bn::fixed_point pos = _sprite->position();
-            int z = -pos.y().integer();
-            _sprite->set_z_order(z);
-
             if(_show_health_bar)
             {
                 _health_bar.update(
-                    pos, _health, _max_health, z
+                    _sprite->position(), _health, _max_health, _depth * EntitySprite::depth_z_orders
                 );
             }
         }
@@ -157,6 +143,12 @@ bn::fixed_point Entity::position() const
     return _sprite ? _sprite->position() : bn::fixed_point();
 }
 
+bn::fixed_point Entity::feet_position() const
+{
+    const bn::fixed_point pos = position();
+    return _get_feet_position(pos, pos);
+}
+
 bool Entity::is_attacking() const
 {
     if(!_sprite)
@@ -204,22 +196,6 @@ void Entity::take_damage(int amount, const bn::fixed_point& source_pos)
     DamageNumbers::spawn(position(), amount);
 }
 
-bool Entity::overlaps(const Entity& other) const
-{
-    return hitboxes_intersect(
-        _hurt_box,  position(),
-        other._hurt_box, other.position()
-    );
-}
-
-bool Entity::attack_hits(const Entity& other) const
-{
-    return hitboxes_intersect(
-        _attack_box, position(),
-        other._hurt_box, other.position()
-    );
-}
-
 void Entity::_tick_invulnerability()
 {
     if(_invuln_timer > 0)
@@ -239,15 +215,13 @@ void Entity::_start_knockback(const bn::fixed_point& source_pos)
     bn::fixed dx = pos.x() - source_pos.x();
     bn::fixed dy = pos.y() - source_pos.y();
 
-    bn::fixed len_sq = dx * dx + dy * dy;
-    if(len_sq == 0)
+    if(dx == 0 && dy == 0)
     {
         _knockback_dir = bn::fixed_point(0, -1);
     }
     else
     {
-        bn::fixed len = bn::sqrt(len_sq);
-        _knockback_dir = bn::fixed_point(dx / len, dy / len);
+        _knockback_dir = fixed_math::normalize(bn::fixed_point(dx, dy));
     }
 
     _knockback_timer = _knockback_duration;
@@ -1,281 +1,409 @@
 #include "entity_manager.h"
 #include "hitbox.h"
+#include "world_map.h"
+#include "game_input.h"
 
-EntityManager::EntityManager(Player* player, RoomId room) :
-    _player(player), _current_room(room)
+EntityManager::EntityManager(Player* player, const WorldMap* world_map) :
+    _player(player), _world_map(world_map), _flow_field(world_map, Enemy::hurt_half_width)
 {
-}
-
-EntityManager::RoomEnemies* EntityManager::_find_room_bucket(RoomId room)
-{
-    for(int i = 0; i < _rooms.size(); ++i)
+    if(_player)
     {
-        if(_rooms[i].room == room)
-        {
-            return &_rooms[i];
-        }
+        _depth_order.push_back(_player);
     }
-    return nullptr;
 }
 
-EntityManager::RoomEnemies& EntityManager::_ensure_room_bucket(RoomId room)
+void EntityManager::set_player(Player* player)
 {
-    if(RoomEnemies* existing = _find_room_bucket(room))
+    _remove_depth(_player);
+    _player = player;
+
+    if(_player)
     {
-        return *existing;
+        _depth_order.push_back(_player);
     }
-
-    BN_ASSERT(_rooms.size() < max_rooms, "Too many rooms in EntityManager");
-
-    RoomEnemies bucket;
-    bucket.room = room;
-    bucket.enemies.clear();
-
-    _rooms.push_back(bucket);
-    return _rooms.back();
 }
 
-void EntityManager::set_current_room(RoomId room)
+void EntityManager::enter_room(RoomId room)
 {
-    if(_current_room == room)
-    {
-        return;
-    }
-
-    RoomEnemies& cur_bucket = _ensure_room_bucket(_current_room);
-    cur_bucket.enemies = _enemies;   // save pointer list for that room
+    const RoomId previous_room = _current_room;
+    _current_room = room;
 
-    for(Enemy* enemy : cur_bucket.enemies)
+    // Enemies only exist while their room is the current one: the ones
+    // chasing the player leave the room as followers
+    if(previous_room != room)
     {
-        if(enemy)
+        for(Enemy* enemy : _enemies)
         {
-            enemy->set_active(false);
+            if(enemy && enemy->is_pursuing())
+            {
+                _add_follower(*enemy, previous_room);
+            }
         }
     }
 
-    // 2) Switch current room id
-    _current_room = room;
+    clear_enemies();
 
-    // 3) Load enemies for the new room
-    RoomEnemies& new_bucket = _ensure_room_bucket(room);
-    _enemies = new_bucket.enemies;
+    const RoomData& room_data = g_rooms[static_cast<int>(room)];
+    for(int i = 0; i < room_data.spawn_count; ++i)
+    {
+        const SpawnData& spawn = room_data.spawns[i];
+        spawn_enemy(bn::fixed_point(spawn.x_px, spawn.y_px));
+    }
 
-    // 4) Activate enemies in the new room so they appear and run AI
-    for(Enemy* enemy : _enemies)
+    // Followers on their way through the room just entered come out of the
+    // door they were walking to
+    for(int index = 0; index < _followers.size(); )
     {
-        if(enemy)
+        Follower& follower = _followers[index];
+
+        if(follower.room == room)
         {
-            enemy->set_active(true);
+            if(Enemy* enemy = spawn_enemy(RoomGraph::door_center(room, follower.door)))
+            {
+                enemy->set_health(follower.health);
+            }
+
+            _followers.erase(_followers.begin() + index);
+        }
+        else
+        {
+            ++index;
         }
     }
 }
 
-void EntityManager::add_enemy(Enemy* enemy, RoomId room)
+Enemy* EntityManager::spawn_enemy(const bn::fixed_point& pos)
 {
+    Enemy* enemy = _pool.acquire(pos, _world_map);
     if(!enemy)
     {
-        return;
+        return nullptr;
     }
 
-    // Get or create the bucket for the specific room
-    RoomEnemies& bucket = _ensure_room_bucket(room);
-
-    // Enforce room-local capacity
-    if(bucket.enemies.size() >= max_enemies)
+    if(_camera)
     {
-        return;
+        enemy->attach_camera(*_camera);
     }
 
-    // Add to that room's persistent list
-    bucket.enemies.push_back(enemy);
+    enemy->set_target(_player);
+    enemy->set_flow_field(&_flow_field);
+    _depth_order.push_back(enemy);
 
-    // If this is also the *current* room, mirror into the active list
-    if(_current_room == room)
+    // Reuse the entry of a released enemy if there is one. The grid picks
+    // the enemy up on the next update.
+    for(Enemy*& entry : _enemies)
     {
-        if(_enemies.size() < max_enemies)
+        if(!entry)
         {
-            _enemies.push_back(enemy);
-            enemy->set_active(true);
+            entry = enemy;
+            return enemy;
         }
-        else
-        {
-            enemy->set_active(false);
-        }
-    }
-    else
-    {
-        // Not the current room; keep it inactive for now
-        enemy->set_active(false);
     }
+
+    _enemies.push_back(enemy);
+    return enemy;
 }
 
 void EntityManager::clear_enemies()
 {
-    // Clear only the current room's enemies
-    RoomEnemies& bucket = _ensure_room_bucket(_current_room);
-    bucket.enemies.clear();
+    for(Enemy* enemy : _enemies)
+    {
+        if(enemy)
+        {
+            _remove_depth(enemy);
+            _pool.release(enemy);
+        }
+    }
 
     _enemies.clear();
+    _grid.clear();
 }
 
-void EntityManager::update()
+void EntityManager::add_systems(FrameScheduler& scheduler)
 {
-    _update_all();
-    _handle_player_attacks_enemies();
-    _handle_enemy_attacks_player();
-    _handle_bumps();
+    scheduler.add<EntityManager, &EntityManager::update_input>(FramePhase::Input, "entity input", *this);
+    scheduler.add<EntityManager, &EntityManager::update_ai>(FramePhase::AI, "entity ai", *this);
+    scheduler.add<EntityManager, &EntityManager::update_movement>(FramePhase::Movement, "entity move", *this);
+    scheduler.add<EntityManager, &EntityManager::update_combat>(FramePhase::Combat, "entity combat", *this);
+    scheduler.add<EntityManager, &EntityManager::update_animation>(FramePhase::Animation, "entity anim", *this);
+    scheduler.add<EntityManager, &EntityManager::sync_render>(FramePhase::RenderSync, "entity render", *this);
 }
 
-void EntityManager::_update_all()
+// Call func for the player and every enemy of the current room
+template<typename Func>
+void EntityManager::_for_each_entity(Func&& func)
 {
     if(_player)
     {
-        _player->update();
+        func(*_player);
     }
 
     for(Enemy* enemy : _enemies)
     {
         if(enemy)
         {
-            enemy->update();
+            func(*enemy);
         }
     }
 }
 
-template<typename Func>
-void EntityManager::_for_each_alive_enemy(Func&& func)
+void EntityManager::update_input()
 {
-    for(Enemy* enemy : _enemies)
-    {
-        if(!enemy || !enemy->is_alive())
-        {
-            continue;
-        }
-        func(enemy);
-    }
+    _for_each_entity([](Entity& entity) { entity.update_input(); });
 }
 
-void EntityManager::_handle_player_attacks_enemies()
+void EntityManager::update_ai()
 {
-    if(!_player || !_player->is_alive() || !_player->is_attacking())
+    _update_followers();
+
+    if(_player && _player->is_alive())
     {
-        return;
+        _flow_field.update(_world_map->world_to_tile(_player->feet_position()));
     }
 
-    _for_each_alive_enemy([&](Enemy* enemy)
-    {
-        if(_player->attack_hits(*enemy))
-        {
-            enemy->take_damage(_player->damage(), _player->position());
-        }
-    });
+    _for_each_entity([](Entity& entity) { entity.update_ai(); });
+}
+
+void EntityManager::update_movement()
+{
+    _for_each_entity([](Entity& entity) { entity.update_movement(); });
+
+    _update_grid();
+    _handle_bumps();
+
+    // Bumps move enemies too: put the pushed ones in their new cells, so
+    // combat and the next frame's bumps don't query stale cells
+    _update_grid();
+}
+
+void EntityManager::update_combat()
+{
+    _handle_player_attacks_enemies();
+    _handle_enemy_attacks_player();
+}
+
+void EntityManager::update_animation()
+{
+    _for_each_entity([](Entity& entity) { entity.update_animation(); });
+
+    _release_finished();
 }
 
-void EntityManager::_handle_enemy_attacks_player()
+// Follow the player out of room
+void EntityManager::_add_follower(const Enemy& enemy, RoomId room)
 {
-    if(!_player || !_player->is_alive())
+    if(_followers.full())
     {
         return;
     }
 
-    _for_each_alive_enemy([&](Enemy* enemy)
+    Follower follower{ room, 0, 0, enemy.health(), enemy.max_speed() };
+
+    if(_route_follower(follower, enemy.position()))
     {
-        if(enemy->is_attacking() && enemy->attack_hits(*_player))
-        {
-            _player->take_damage(enemy->damage(), enemy->position());
-        }
-    });
+        _followers.push_back(follower);
+    }
 }
 
-void EntityManager::_handle_bumps()
+// Send a follower standing at pos to the next door toward the player's room
+bool EntityManager::_route_follower(Follower& follower, const bn::fixed_point& pos)
 {
-    // Player vs enemies
-    if(_player && _player->is_alive())
+    const bn::optional<RoomGraph::Route> route = _room_graph.route(follower.room, pos, _current_room);
+
+    if(!route)
     {
-        _for_each_alive_enemy([&](Enemy* enemy)
-        {
-            if(_player->overlaps(*enemy))
-            {
-                _separate_pair(_player, enemy);
-            }
-        });
+        return false;
     }
 
-    // Enemy vs enemy separation
-    const int enemy_count = _enemies.size();
-    for(int i = 0; i < enemy_count; ++i)
+    follower.door = route->door;
+    follower.frames = (bn::fixed(route->door_distance) / follower.speed).ceil_integer();
+    return true;
+}
+
+// Walk the followers: through each door they either arrive in the player's
+// room or head for the next door toward it
+void EntityManager::_update_followers()
+{
+    for(int index = 0; index < _followers.size(); )
     {
-        Enemy* a = _enemies[i];
-        if(!a || !a->is_alive())
+        Follower& follower = _followers[index];
+
+        if(follower.frames > 0)
         {
+            --follower.frames;
+            ++index;
             continue;
         }
 
-        for(int j = i + 1; j < enemy_count; ++j)
+        const DoorData& door = g_rooms[static_cast<int>(follower.room)].doors[follower.door];
+        const bn::fixed_point arrival_pos(door.target_x_px, door.target_y_px);
+        bool done = true;
+
+        if(door.target_room == _current_room)
         {
-            Enemy* b = _enemies[j];
-            if(!b || !b->is_alive())
+            if(Enemy* enemy = spawn_enemy(arrival_pos))
             {
-                continue;
+                enemy->set_health(follower.health);
             }
-
-            if(a->overlaps(*b))
+            else
             {
-                _separate_pair(a, b);
+                // Pool full: wait behind the door
+                done = false;
             }
         }
+        else
+        {
+            follower.room = door.target_room;
+            done = !_route_follower(follower, arrival_pos);
+        }
+
+        if(done)
+        {
+            _followers.erase(_followers.begin() + index);
+        }
+        else
+        {
+            ++index;
+        }
     }
 }
 
-// Minimal AABB penetration resolution using hurt boxes
-void EntityManager::_separate_pair(Entity* a, Entity* b)
+// Give the slots of the enemies done dying back to the pool
+void EntityManager::_release_finished()
 {
-    if(!a || !b)
+    for(int index = 0; index < _enemies.size(); ++index)
     {
-        return;
+        Enemy* enemy = _enemies[index];
+
+        if(enemy && enemy->is_finished())
+        {
+            _grid.remove(index);
+            _remove_depth(enemy);
+            _pool.release(enemy);
+            _enemies[index] = nullptr;
+        }
     }
-    const Hitbox& ha = a->hurt_box();
-    const Hitbox& hb = b->hurt_box();
+}
 
-    const bn::fixed_point pa = a->position();
-    const bn::fixed_point pb = b->position();
+void EntityManager::sync_render()
+{
+    _sort_depth();
+    _for_each_entity([](Entity& entity) { entity.sync_render(); });
+}
 
-    const bn::fixed_point ca = ha.center(pa);
-    const bn::fixed_point cb = hb.center(pb);
+void EntityManager::_remove_depth(Entity* entity)
+{
+    for(int index = 0; index < _depth_order.size(); ++index)
+    {
+        if(_depth_order[index] == entity)
+        {
+            _depth_order.erase(_depth_order.begin() + index);
+            return;
+        }
+    }
+}
 
-    const bn::fixed dx = ca.x() - cb.x();
-    const bn::fixed dy = ca.y() - cb.y();
+// Y-sort: bigger feet Y = closer to the camera (in front). Entities keep
+// their order from the last frame unless they crossed, so an insertion sort
+// is close to one pass, and only the entities whose depth changed get new
+// z-orders. Equal feet Y keep their order (no flickering).
+void EntityManager::_sort_depth()
+{
+    const int count = _depth_order.size();
+    bn::fixed feet_y[max_enemies + 1];
 
-    // How much they overlap on each axis
-    const bn::fixed overlap_x = ha.half_width  + hb.half_width  - bn::abs(dx);
-    const bn::fixed overlap_y = ha.half_height + hb.half_height - bn::abs(dy);
+    for(int index = 0; index < count; ++index)
+    {
+        feet_y[index] = _depth_order[index]->feet_position().y();
+    }
 
-    // No actual overlap (just touching or separated)
-    if(overlap_x <= 0 || overlap_y <= 0)
+    for(int index = 1; index < count; ++index)
     {
-        return;
+        Entity* entity = _depth_order[index];
+        const bn::fixed y = feet_y[index];
+        int target = index;
+
+        while(target > 0 && feet_y[target - 1] < y)
+        {
+            _depth_order[target] = _depth_order[target - 1];
+            feet_y[target] = feet_y[target - 1];
+            --target;
+        }
+
+        _depth_order[target] = entity;
+        feet_y[target] = y;
     }
 
-    // Helper to move them symmetrically
-    auto separate = [&](const bn::fixed_point& delta)
+    for(int index = 0; index < count; ++index)
     {
-        a->move_by(delta);
-        b->move_by(-delta);
+        Entity* entity = _depth_order[index];
+
+        if(entity->depth() != index)
+        {
+            entity->set_depth(index);
+        }
+    }
+}
+
+uint32_t EntityManager::state_checksum() const
+{
+    uint32_t checksum = GameInput::checksum(GameInput::checksum_seed, static_cast<int>(_current_room));
+
+    auto add_entity = [&checksum](const Entity& entity)
+    {
+        const bn::fixed_point position = entity.position();
+        checksum = GameInput::checksum(checksum, position.x().data());
+        checksum = GameInput::checksum(checksum, position.y().data());
+        checksum = GameInput::checksum(checksum, entity.health());
     };
 
-    // Resolve along the "cheapest" axis
-    if(overlap_x < overlap_y)
+    if(_player)
+    {
+        add_entity(*_player);
+    }
+
+    for(const Enemy* enemy : _enemies)
     {
-        const bn::fixed push = overlap_x / 2;
-        const bn::fixed dir  = (dx > 0) ? bn::fixed(1) : bn::fixed(-1);
+        checksum = GameInput::checksum(checksum, enemy != nullptr);
 
-        separate(bn::fixed_point(push * dir, 0));
+        if(enemy)
+        {
+            add_entity(*enemy);
+        }
     }
-    else
+
+    for(const Follower& follower : _followers)
     {
-        const bn::fixed push = overlap_y / 2;
-        const bn::fixed dir  = (dy > 0) ? bn::fixed(1) : bn::fixed(-1);
+        checksum = GameInput::checksum(checksum, static_cast<int>(follower.room));
+        checksum = GameInput::checksum(checksum, follower.door);
+        checksum = GameInput::checksum(checksum, follower.frames);
+        checksum = GameInput::checksum(checksum, follower.health);
+    }
+
+    return checksum;
+}
+
+// Move the enemies that changed cell since the last frame, and drop the dead
+void EntityManager::_update_grid()
+{
+    _attack_reach_x = 0;
+    _attack_reach_y = 0;
+
+    for(int index = 0; index < _enemies.size(); ++index)
+    {
+        Enemy* enemy = _enemies[index];
+
+        if(!enemy || !enemy->is_alive())
+        {
+            _grid.remove(index);
+            continue;
+        }
+
+        const Hitbox& hurt = enemy->hurt_box();
+        const Hitbox& attack = enemy->attack_box();
+        _grid.update(index, hurt.center(enemy->position()), hurt.half_width, hurt.half_height);
 
-        separate(bn::fixed_point(0, push * dir));
+        _attack_reach_x = bn::max(_attack_reach_x, bn::abs(attack.offset_x - hurt.offset_x) + attack.half_width);
+        _attack_reach_y = bn::max(_attack_reach_y, bn::abs(attack.offset_y - hurt.offset_y) + attack.half_height);
     }
 }
@@ -0,0 +1,284 @@
+#include "flow_field.h"
+
+#include "bn_math.h"
+
+#include "world_map.h"
+
+FlowField::FlowField(const WorldMap* world_map, int clearance) :
+    _world_map(world_map),
+    // Box centered on a tile: how far it reaches past the tile, in tiles
+    _clearance_tiles(bn::max(clearance - TILE_SIZE / 2 + TILE_SIZE - 1, 0) / TILE_SIZE)
+{
+}
+
+void FlowField::update(const bn::point& goal_tile, int budget)
+{
+    const RoomId room = _world_map->current_room();
+
+    if(room != _room)
+    {
+        // Distances of another room would send enemies into walls
+        _front_valid = false;
+        _start(goal_tile);
+    }
+    else if(!_building && !_repairing)
+    {
+        // A rebuild or repair in progress is finished first, otherwise a
+        // moving goal would restart it before it is ever done
+        if(_world_map->collision_revision() != _revision)
+        {
+            _start(goal_tile);
+        }
+        else if(goal_tile != _goal && !_start_repair(goal_tile))
+        {
+            _start(goal_tile);
+        }
+    }
+
+    if(_building || _repairing)
+    {
+        _expand(budget);
+    }
+}
+
+int FlowField::distance(int tx, int ty) const
+{
+    if(!_front_valid)
+    {
+        return -1;
+    }
+
+    const bn::point& origin = _origins[_front];
+    const int x = tx - origin.x();
+    const int y = ty - origin.y();
+
+    if(x < 0 || x >= size || y < 0 || y >= size)
+    {
+        return -1;
+    }
+
+    const int16_t distance = _distances[_front][y * size + x];
+    return distance <= blocked ? -1 : distance + _bias;
+}
+
+bn::optional<bn::point> FlowField::next_tile(const bn::point& tile) const
+{
+    const int current = distance(tile.x(), tile.y());
+
+    if(current == 0)
+    {
+        return bn::nullopt;
+    }
+
+    const bn::point neighbours[4] = {
+        bn::point(tile.x() + 1, tile.y()),
+        bn::point(tile.x() - 1, tile.y()),
+        bn::point(tile.x(), tile.y() + 1),
+        bn::point(tile.x(), tile.y() - 1)
+    };
+
+    bn::optional<bn::point> result;
+    int best = current;
+
+    for(const bn::point& neighbour : neighbours)
+    {
+        const int next = distance(neighbour.x(), neighbour.y());
+
+        if(next >= 0 && (best < 0 || next < best))
+        {
+            best = next;
+            result = neighbour;
+        }
+    }
+
+    return result;
+}
+
+// Whole room if it fits, otherwise centered on the goal
+bn::point FlowField::_window_origin(const bn::point& goal_tile) const
+{
+    const int room_width  = _world_map->pixel_width() / TILE_SIZE;
+    const int room_height = _world_map->pixel_height() / TILE_SIZE;
+
+    return bn::point(bn::clamp(goal_tile.x() - size / 2, 0, bn::max(room_width - size, 0)),
+                     bn::clamp(goal_tile.y() - size / 2, 0, bn::max(room_height - size, 0)));
+}
+
+// Feet boxes are less than a tile tall, so only the row of the tile matters
+bool FlowField::_is_clear(int tx, int ty) const
+{
+    return !_world_map->any_solid_in_span(ty, tx - _clearance_tiles, tx + _clearance_tiles);
+}
+
+void FlowField::_start(const bn::point& goal_tile)
+{
+    _room = _world_map->current_room();
+    _revision = _world_map->collision_revision();
+    _goal = goal_tile;
+
+    const int back = 1 - _front;
+    const bn::point origin = _window_origin(goal_tile);
+    _origins[back] = origin;
+
+    int16_t* distances = _distances[back];
+
+    for(int index = 0; index < cells; ++index)
+    {
+        distances[index] = unreached;
+    }
+
+    _queue_head = 0;
+    _queue_tail = 0;
+    _building = true;
+    _repairing = false;
+
+    // Seed the goal even if it is solid (e.g. feet touching a wall)
+    const int x = goal_tile.x() - origin.x();
+    const int y = goal_tile.y() - origin.y();
+
+    if(x >= 0 && x < size && y >= 0 && y < size)
+    {
+        const int index = y * size + x;
+        distances[index] = 0;
+        _queue[_queue_tail++] = uint16_t(index);
+    }
+}
+
+// Move the goal of the front field. Every old distance plus the length of a
+// path from the new goal to the old one is the length of a path to the new
+// goal, so raising all of them by that much (through _bias) leaves a valid
+// field, and a search from the new goal only has to visit the tiles that get
+// closer. Returns false if the field must be rebuilt instead.
+bool FlowField::_start_repair(const bn::point& goal_tile)
+{
+    if(!_front_valid)
+    {
+        return false;
+    }
+
+    // Keep the window while the goal is not near its edges
+    const bn::point& origin = _origins[_front];
+    const int x = goal_tile.x() - origin.x();
+    const int y = goal_tile.y() - origin.y();
+
+    if(_window_origin(goal_tile) != origin &&
+       (x < size / 4 || x >= size * 3 / 4 || y < size / 4 || y >= size * 3 / 4))
+    {
+        return false;
+    }
+
+    // Paths through the old goal are only valid if it is a searched tile
+    if(!_is_clear(_goal.x(), _goal.y()))
+    {
+        return false;
+    }
+
+    // Path from the new goal to the old one: through the goal tile itself,
+    // or through one of its neighbours if it is left out of the search
+    int moved = distance(goal_tile.x(), goal_tile.y());
+
+    if(moved < 0)
+    {
+        const int steps[4] = {
+            distance(goal_tile.x() + 1, goal_tile.y()), distance(goal_tile.x() - 1, goal_tile.y()),
+            distance(goal_tile.x(), goal_tile.y() + 1), distance(goal_tile.x(), goal_tile.y() - 1)
+        };
+
+        for(int step : steps)
+        {
+            if(step >= 0 && (moved < 0 || step + 1 < moved))
+            {
+                moved = step + 1;
+            }
+        }
+    }
+
+    if(moved < 0 || _bias + moved > max_bias)
+    {
+        return false;
+    }
+
+    _bias += moved;
+    _goal = goal_tile;
+
+    const int index = y * size + x;
+    _distances[_front][index] = int16_t(-_bias);
+    _queue_head = 0;
+    _queue_tail = 0;
+    _queue[_queue_tail++] = uint16_t(index);
+    _repairing = true;
+    return true;
+}
+
+void FlowField::_expand(int budget)
+{
+    const int field = _building ? 1 - _front : _front;
+    const int bias = _building ? 0 : _bias;
+    const int16_t* distances = _distances[field];
+
+    while(budget > 0 && _queue_head < _queue_tail)
+    {
+        const int index = _queue[_queue_head++];
+        const int x = index % size;
+        const int y = index / size;
+        const int next = distances[index] + bias + 1;
+
+        _visit(field, x + 1, y, next);
+        _visit(field, x - 1, y, next);
+        _visit(field, x, y + 1, next);
+        _visit(field, x, y - 1, next);
+
+        --budget;
+    }
+
+    if(_queue_head == _queue_tail)
+    {
+        if(_building)
+        {
+            // Done: the new field becomes the one enemies read
+            _front = 1 - _front;
+            _front_valid = true;
+            _bias = 0;
+        }
+
+        _building = false;
+        _repairing = false;
+    }
+}
+
+void FlowField::_visit(int field, int x, int y, int distance)
+{
+    if(x < 0 || x >= size || y < 0 || y >= size)
+    {
+        return;
+    }
+
+    const int bias = field == _front ? _bias : 0;
+    const int index = y * size + x;
+    int16_t& cell = _distances[field][index];
+
+    if(cell == blocked)
+    {
+        return;
+    }
+
+    if(cell == unreached)
+    {
+        const bn::point& origin = _origins[field];
+
+        if(!_is_clear(origin.x() + x, origin.y() + y))
+        {
+            // Only test each tile once
+            cell = blocked;
+            return;
+        }
+    }
+    else if(cell + bias <= distance)
+    {
+        // Already as close (always the case during a rebuild)
+        return;
+    }
+
+    cell = int16_t(distance - bias);
+    _queue[_queue_tail++] = uint16_t(index);
+}
@@ -1,19 +1,21 @@
 #include "player.h"
 
-#include "bn_keypad.h"
 #include "bn_math.h"
 
 #include "world_map.h"
+#include "fixed_math.h"
+#include "game_input.h"
 
 Player::Player(PlayerSprite* sprite,
                const bn::fixed_point& start_pos,
                const WorldMap* world) :
     Entity(
-        sprite, world, 100, 1, Hitbox(0, 0, 6, 6), Hitbox(0, 0, 6, 6), 60
+        sprite, world, 100, 1, Hitbox(0, 0, 6, 6), Hitbox(0, 0, 6, 6), k_invuln_frames
     ),
     _direction(FacingDirection::Down),
     _sprite(sprite)
 {
+    _set_knockback(k_knockback_frames, k_knockback_strength);
     _sprite->rebuild(start_pos);
 }
 
@@ -29,40 +31,41 @@ void Player::_handle_input()
     _move_dx = 0;
     _move_dy = 0;
 
-    if(bn::keypad::left_held())
+    if(GameInput::held(bn::keypad::key_type::LEFT))
     {
         _move_dx -= k_speed;
         _direction = FacingDirection::Left;
     }
-    else if(bn::keypad::right_held())
+    else if(GameInput::held(bn::keypad::key_type::RIGHT))
     {
         _move_dx += k_speed;
         _direction = FacingDirection::Right;
     }
 
-    if(bn::keypad::up_held())
+    if(GameInput::held(bn::keypad::key_type::UP))
     {
         _move_dy -= k_speed;
         _direction = FacingDirection::Up;
     }
-    else if(bn::keypad::down_held())
+    else if(GameInput::held(bn::keypad::key_type::DOWN))
     {
         _move_dy += k_speed;
         _direction = FacingDirection::Down;
     }
 
-    if(bn::keypad::a_pressed())
+    if(GameInput::pressed(bn::keypad::key_type::A))
     {
         _sprite->play_attack();
     } 
 
     _moving = (_move_dx != 0 || _move_dy != 0);
 
-    // Normalize diagonal speed a bit
+    // Same speed on diagonals: scale both axes by cos(45 degrees)
     if(_move_dx != 0 && _move_dy != 0)
     {
-        _move_dx *= bn::fixed(0.707);
-        _move_dy *= bn::fixed(0.707);
+        const bn::fixed diagonal = fixed_math::cos(fixed_math::k_turn / 8);
+        _move_dx *= diagonal;
+        _move_dy *= diagonal;
     }
 }
 
@@ -79,29 +82,15 @@ bn::fixed_point Player::_get_feet_position(const bn::fixed_point& old_pos, const
 
 void Player::_apply_movement(bn::fixed_point& new_pos)
 {
-    // Try X axis
-    if(_move_dx != 0)
+    if(_move_dx == 0 && _move_dy == 0)
     {
-        bn::fixed_point test = new_pos;
-        test.set_x(test.x() + _move_dx);
-
-        if(_can_stand_at(new_pos, test))
-        {
-            new_pos.set_x(test.x());
-        }
+        return;
     }
 
-    // Try Y axis
-    if(_move_dy != 0)
-    {
-        bn::fixed_point test = new_pos;
-        test.set_y(test.y() + _move_dy);
-
-        if(_can_stand_at(new_pos, test))
-        {
-            new_pos.set_y(test.y());
-        }
-    }
+    // One sweep for both axes: slides along walls and stops flush against them
+    const SweepResult sweep = _sweep(new_pos, bn::fixed_point(_move_dx, _move_dy));
+    new_pos.set_x(new_pos.x() + sweep.delta.x());
+    new_pos.set_y(new_pos.y() + sweep.delta.y());
 }
 
 void Player::_update_camera()
@@ -137,10 +126,8 @@ void Player::_update_camera()
     _camera->set_y(cy);
 }
 
-void Player::update()
+void Player::update_input()
 {
-    bn::fixed_point new_pos = _sprite->position();
-
     if(_sprite->is_locked())
     {
         // No movement input while anim plays
@@ -151,11 +138,29 @@ void Player::update()
     else
     {
         _handle_input();
+    }
+}
+
+void Player::update_movement()
+{
+    if(_moving)
+    {
+        bn::fixed_point new_pos = _sprite->position();
         _apply_movement(new_pos);
+        _sprite->set_position(new_pos);
     }
 
-    _sprite->update(new_pos, _direction, _moving);
+    Entity::update_movement();
+}
+
+void Player::update_animation()
+{
+    _sprite->update(_sprite->position(), _direction, _moving);
+}
+
+void Player::sync_render()
+{
     _update_camera();
 
-    update_entity();
+    Entity::sync_render();
 }
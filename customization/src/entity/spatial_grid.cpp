@@ -0,0 +1,100 @@
+#include "spatial_grid.h"
+
+#include "bn_assert.h"
+
+SpatialGrid::SpatialGrid()
+{
+    clear();
+}
+
+void SpatialGrid::clear()
+{
+    for(int16_t& head : _heads)
+    {
+        head = -1;
+    }
+
+    for(Cell& cell : _cells)
+    {
+        cell = Cell();
+    }
+
+    _max_half_width = 0;
+    _max_half_height = 0;
+}
+
+void SpatialGrid::update(int item, const bn::fixed_point& center, bn::fixed half_width, bn::fixed half_height)
+{
+    BN_ASSERT(item >= 0 && item < max_items, "Invalid spatial grid item: ", item);
+
+    _max_half_width = bn::max(_max_half_width, half_width);
+    _max_half_height = bn::max(_max_half_height, half_height);
+
+    const int cell_x = center.x().floor_integer() >> cell_shift;
+    const int cell_y = center.y().floor_integer() >> cell_shift;
+    Cell& cell = _cells[item];
+
+    if(cell.stored)
+    {
+        if(cell.x == cell_x && cell.y == cell_y)
+        {
+            return;
+        }
+
+        _unlink(item);
+    }
+
+    cell.x = cell_x;
+    cell.y = cell_y;
+    _link(item);
+}
+
+void SpatialGrid::remove(int item)
+{
+    BN_ASSERT(item >= 0 && item < max_items, "Invalid spatial grid item: ", item);
+
+    if(_cells[item].stored)
+    {
+        _unlink(item);
+    }
+}
+
+void SpatialGrid::_link(int item)
+{
+    Cell& cell = _cells[item];
+    int16_t& head = _heads[_bucket(cell.x, cell.y)];
+
+    cell.prev = -1;
+    cell.next = head;
+    cell.stored = true;
+
+    if(head >= 0)
+    {
+        _cells[head].prev = item;
+    }
+
+    head = item;
+}
+
+void SpatialGrid::_unlink(int item)
+{
+    Cell& cell = _cells[item];
+
+    if(cell.prev >= 0)
+    {
+        _cells[cell.prev].next = cell.next;
+    }
+    else
+    {
+        _heads[_bucket(cell.x, cell.y)] = cell.next;
+    }
+
+    if(cell.next >= 0)
+    {
+        _cells[cell.next].prev = cell.prev;
+    }
+
+    cell.prev = -1;
+    cell.next = -1;
+    cell.stored = false;
+}
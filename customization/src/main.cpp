@@ -11,16 +11,30 @@
 #include "bn_regular_bg_map_cell.h"
 #include "bn_regular_bg_items_bg.h"
 #include "bn_sprite_text_generator.h"
+#include "bn_timer.h"
 
 #include "common_fixed_8x8_sprite_font.h"
+#include "common_variable_8x8_sprite_font.h"
 
+#include "benchmark.h"
 #include "customization_screen.h"
+#include "frame_scheduler.h"
+#include "game_input.h"
 #include "player.h"
-#include "enemy.h"
-#include "enemy_sprite.h"
 #include "entity_manager.h"
 #include "world_map.h"
+#include "room_graph.h"
 #include "damage_numbers.h"
+#include "profiler_overlay.h"
+
+#ifdef FIXED_MATH_BENCHMARK
+#include "fixed_math_benchmark.h"
+#endif
+
+#ifdef HOT_CODE_PROFILE
+#include "bn_log.h"
+#include "hot_code.h"
+#endif
 
 void update_camera(bn::camera_ptr& camera, WorldMap* world, bn::fixed_point& pos)
 {
@@ -52,10 +66,36 @@ void update_camera(bn::camera_ptr& camera, WorldMap* world, bn::fixed_point& pos
     camera.set_y(cy);
 }
 
+// Wait for the next frame and sample its input
+void next_frame()
+{
+    Benchmark::frame_ended();
+    bn::core::update();
+    GameInput::update();
+    Benchmark::frame_started();
+}
+
 int main()
 {
     bn::core::init();
 
+    // Build with -DINPUT_RECORD to record the session to SRAM, or with
+    // -DINPUT_REPLAY to play the recorded one back and check it. Benchmark
+    // builds (make bench) play their scenario script instead.
+#if defined(BENCHMARK_SCENARIO)
+    Benchmark::initialize(BENCHMARK_SCENARIO);
+#elif defined(INPUT_RECORD)
+    GameInput::initialize(GameInput::Mode::Record);
+#elif defined(INPUT_REPLAY)
+    GameInput::initialize(GameInput::Mode::Replay);
+#else
+    GameInput::initialize(GameInput::Mode::Live);
+#endif
+
+#ifdef FIXED_MATH_BENCHMARK
+    run_fixed_math_benchmark();
+#endif
+
     // -----------------------------
     // 1) Character customization
     // -----------------------------
@@ -66,10 +106,16 @@ int main()
 
         CustomizationScreen customization;
 
-        while(!customization.done())
+        // Gameplay benchmarks start with the default appearance
+        const bool customize = !Benchmark::active() || Benchmark::scenario() == Benchmark::Scenario::MenuSpam;
+
+        while(customize && !customization.done())
         {
+            bn::timer menu_timer;
             customization.update();
-            bn::core::update();
+            Benchmark::record("menu", menu_timer.elapsed_ticks());
+
+            next_frame();
         }
 
         // Grab chosen appearance
@@ -91,36 +137,83 @@ int main()
     world->set_camera(camera);
 
     // 4) Create player + attach same camera
-    PlayerSprite player_sprite(appearance);
+    // One hardware sprite for the player, instead of one per layer
+    PlayerSprite player_sprite(appearance, PlayerSprite::RenderMode::Composited);
     Player player(&player_sprite, bn::fixed_point(0, 0), world);
     player.attach_camera(camera);
 
-    EntityManager entity_manager(&player, RoomId::MainRoom);
+    // The enemy pool is too big for the stack
+    EntityManager* entity_manager = new EntityManager(&player, world);
+    entity_manager->set_camera(camera);
+    entity_manager->enter_room(RoomId::MainRoom);
 
-    EnemySprite enemy_sprite1(bn::fixed_point(-200, 0));
-    Enemy enemy1(&enemy_sprite1, world);
-    enemy1.attach_camera(camera);
-    enemy1.set_target(&player);
-    entity_manager.add_enemy(&enemy1, RoomId::MainRoom);
+    // Chase benchmark: the room enemies replaced by a full pool on rings
+    // around the player
+    if(Benchmark::scenario() == Benchmark::Scenario::Chase)
+    {
+        entity_manager->clear_enemies();
 
-    EnemySprite enemy_sprite2(bn::fixed_point(0, -150));
-    Enemy enemy2(&enemy_sprite2, world);
-    enemy2.attach_camera(camera);
-    enemy2.set_target(&player);
-    entity_manager.add_enemy(&enemy2, RoomId::MainRoom);
+        for(int index = 0; index < Benchmark::chase_enemies; ++index)
+        {
+            const int ring = 48 + (index / 8) * 24;
+            const bn::fixed_point offsets[] = {
+                { ring, 0 }, { -ring, 0 }, { 0, ring }, { 0, -ring },
+                { ring, ring }, { -ring, ring }, { ring, -ring }, { -ring, -ring },
+            };
 
-    EnemySprite enemy_sprite3(bn::fixed_point(50, 200));
-    Enemy enemy3(&enemy_sprite3, world);
-    enemy3.attach_camera(camera);
-    enemy3.set_target(&player);
-    entity_manager.add_enemy(&enemy3, RoomId::MainRoom);
+            entity_manager->spawn_enemy(offsets[index % 8]);
+        }
+    }
+
+    // Every per-frame system runs once per frame, phase by phase
+    FrameScheduler scheduler;
+    entity_manager->add_systems(scheduler);
+    scheduler.add<WorldMap, &WorldMap::update>(FramePhase::RenderSync, "world", *world);
+    scheduler.add(FramePhase::UI, "damage numbers", [](void*) { DamageNumbers::update(); }, nullptr);
+
+    // CPU profiler (L + R + SELECT): the scheduler phases, plus the work done
+    // outside of them
+    bn::sprite_text_generator profiler_text_gen(common::variable_8x8_sprite_font);
+    ProfilerOverlay profiler(profiler_text_gen);
+    const int prefetch_scope = profiler.add_scope("prefetch");
+    const int core_scope = profiler.add_scope("vblank");
+
+#ifdef HOT_CODE_PROFILE
+    // Average bn::timer ticks of the phases running the hot code sets, to compare
+    // HOTCODE placements (see hot_code.h)
+    constexpr int profile_frames = 64;
+    int profile_frame = 0;
+    int movement_ticks = 0;
+    int combat_ticks = 0;
+#endif
 
     while(true)
     {
         // 1) Normal updates
-        player.update();
-        entity_manager.update();
-        world->update();
+        scheduler.run_frame();
+        GameInput::add_checksum(entity_manager->state_checksum());
+        Benchmark::record(scheduler);
+
+#ifdef HOT_CODE_PROFILE
+        movement_ticks += scheduler.phase_ticks(FramePhase::Movement);
+        combat_ticks += scheduler.phase_ticks(FramePhase::Combat);
+
+        if(++profile_frame == profile_frames)
+        {
+            BN_LOG("hot code collision=", HOT_CODE_COLLISION, " combat=", HOT_CODE_COMBAT,
+                   " movement ticks: ", movement_ticks / profile_frames,
+                   " combat ticks: ", combat_ticks / profile_frames);
+            profile_frame = 0;
+            movement_ticks = 0;
+            combat_ticks = 0;
+        }
+#endif
+
+        // Doors benchmark: leave every room through its first door at once
+        if(Benchmark::scenario() == Benchmark::Scenario::Doors)
+        {
+            player.update_sprite(RoomGraph::door_center(entity_manager->current_room(), 0), FacingDirection::Down);
+        }
 
         // 2) Check for door collision using the player's position
         if(auto door = world->check_door_collision(player_sprite.position()))
@@ -129,6 +222,10 @@ int main()
             RoomId target_room = door->room_id;
             bn::fixed_point spawn_pos = door->spawn_pos;
 
+            // Start building the next room; it is decoded a slice per frame
+            // while the screen fades out
+            world->begin_room_load(target_room);
+
             // --- Fade out ---------------------------------------------------
             for(int i = 0; i <= 16; ++i)
             {
@@ -137,12 +234,26 @@ int main()
                 bn::bg_palettes::set_fade(bn::color(0, 0, 0), intensity);
                 bn::sprite_palettes::set_fade(bn::color(0, 0, 0), intensity);
 
+                bn::timer load_timer;
+                world->update_room_load();
+                Benchmark::record("room_load", load_timer.elapsed_ticks());
+
+                next_frame();
+            }
+
+            // Finish loading while the screen stays black, if the fade was too
+            // short. How long this takes depends on timing, so these frames
+            // don't consume input (replays stay in step).
+            while(!world->update_room_load())
+            {
                 bn::core::update();
             }
 
             // --- Actually change the room ----------------------------------
-            world->change_room(target_room);
-            entity_manager.set_current_room(target_room);
+            bn::timer commit_timer;
+            world->commit_room_load();
+            entity_manager->enter_room(target_room);
+            Benchmark::record("room_commit", commit_timer.elapsed_ticks());
 
             // Teleport player to the door's spawn position
             player.update_sprite(spawn_pos, FacingDirection::Down);
@@ -159,15 +270,28 @@ int main()
                 bn::bg_palettes::set_fade(bn::color(0, 0, 0), intensity);
                 bn::sprite_palettes::set_fade(bn::color(0, 0, 0), intensity);
 
-                bn::core::update();
+                next_frame();
             }
         }
 
-        DamageNumbers::update();
+        // Decode the rooms behind the doors for a fixed budget (an eighth of a
+        // frame, WorldMap::prefetch_budget_ticks)
+        bn::timer scope_timer;
+        world->update_prefetch();
+
+        const int prefetch_ticks = scope_timer.elapsed_ticks();
+        profiler.record(prefetch_scope, prefetch_ticks);
+        Benchmark::record("prefetch", prefetch_ticks);
+
+        // bn::core::update waits for the vblank, so this is mostly idle time
+        scope_timer.restart();
+        next_frame();
+        profiler.record(core_scope, scope_timer.elapsed_ticks());
 
-        bn::core::update();
+        profiler.update(scheduler);
     }
 
+    delete entity_manager;
     delete world;
 
     return 0;
@@ -11,6 +11,7 @@ EnemySprite::EnemySprite(const bn::fixed_point& pos) : _sprite_item(bn::sprite_i
 {
     _sprite = _sprite_item.create_sprite(pos);
     _sprite->set_bg_priority(1);
+    _render.set_position(*_sprite, pos);
 }
 
 bn::fixed_point EnemySprite::position()
@@ -20,24 +21,24 @@ bn::fixed_point EnemySprite::position()
 
 void EnemySprite::set_position(bn::fixed_point pos)
 {
-    _sprite->set_position(pos);
+    _render.set_position(*_sprite, pos);
 }
 
 void EnemySprite::set_z_order(int z)
 {
-    _sprite->set_z_order(10 * z);    // multiply by 10 to allow multi-layered sprites
+    _render.set_z_order(*_sprite, depth_z_orders * z);
 }
 
 void EnemySprite::set_visible(bool is_visible)
 {
-    _sprite->set_visible(is_visible);
+    _render.set_visible(*_sprite, is_visible);
 }
 
 void EnemySprite::attach_camera(const bn::camera_ptr& camera)
 {
     _camera = camera;
     if(_sprite)
-        _sprite->set_camera(camera);
+        _render.set_camera(*_sprite, _camera);
 }
 
 void EnemySprite::detach_camera()
@@ -47,7 +48,7 @@ void EnemySprite::detach_camera()
 
     _camera.reset();
     if(_sprite)
-        _sprite->remove_camera();
+        _render.set_camera(*_sprite, _camera);
 }
 
 // ---------------------------------------------------------------------------
@@ -161,7 +162,8 @@ void EnemySprite::_update_death_animation()
         }
         else
         {
-            _sprite->set_z_order(32767);
+            _render.set_z_order(*_sprite, 32767);
+            _death_done = true;
         }
         // Once on last frame, remain there with _state = Death
     }
@@ -175,7 +177,7 @@ void EnemySprite::_sync_sprite(const bn::fixed_point& pos)
     }
 
     // Position
-    _sprite->set_position(pos);
+    _render.set_position(*_sprite, pos);
 
     constexpr int k_frames_per_direction = 28;
 
@@ -229,8 +231,8 @@ void EnemySprite::_sync_sprite(const bn::fixed_point& pos)
     int frame_index = base_frame + rel_frame;
 
     // Apply tiles
-    _sprite->set_tiles(_sprite_item.tiles_item(), frame_index);
+    _render.set_tiles(*_sprite, _sprite_item.tiles_item(), frame_index);
 
     // Apply horizontal flip for left-facing
-    _sprite->set_horizontal_flip(flip_x);
+    _render.set_horizontal_flip(*_sprite, flip_x);
 }
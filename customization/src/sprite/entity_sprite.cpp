@@ -64,6 +64,7 @@ void EntitySprite::play_death()
     _state = AnimationState::Death;
     _anim_counter = 0;
     _death_frame = 0;
+    _death_done = false;
 }
 
 bool EntitySprite::is_locked() const
@@ -4,61 +4,77 @@
 
 #include "player_sprite.h"
 
-#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_palette_items_character_palette.h"
 
-PlayerSprite::PlayerSprite(const CharacterAppearance& appearance) :
+PlayerSprite::PlayerSprite(const CharacterAppearance& appearance, RenderMode mode) :
     _appearance(appearance),
-    _palette(k_body_type_options[0]->palette_item().create_palette())
+    _mode(mode)
 {
+    // New palettes: their ramp colors are changed for this appearance
+    if(_mode == RenderMode::Composited)
+    {
+        _palette = bn::sprite_palette_items::character_palette.create_new_palette();
+        return;
+    }
+
+    // A bank palette starts with the colors of the first sheet using it
+    for(int bank = 0; bank < k_character_palette_banks; ++bank)
+    {
+        for(const CharacterSheet& sheet : k_character_sheets)
+        {
+            if(sheet.bank == bank)
+            {
+                _bank_palettes.push_back(sheet.item->palette_item().create_new_palette());
+                break;
+            }
+        }
+    }
 }
 
 bn::fixed_point PlayerSprite::position()
 {
     if(_body_sprite) 
         return _body_sprite->position();
+    if(_composite_sprite)
+        return _composite_sprite->position();
     return bn::fixed_point();
 }
 
 void PlayerSprite::set_position(bn::fixed_point pos)
 {
-    if(!_body_sprite || !_eyes_sprite || !_top_sprite || !_bottom_sprite || !_hair_sprite)
+    _for_each_sprite([&pos](bn::sprite_ptr& sprite, SpriteRenderState& render)
     {
-        return;
-    }
-
-    _body_sprite->set_position(pos);
-    _eyes_sprite->set_position(pos);
-    _top_sprite->set_position(pos);
-    _bottom_sprite->set_position(pos);
-    _hair_sprite->set_position(pos);
+        render.set_position(sprite, pos);
+    });
 }
 
 void PlayerSprite::set_z_order(int z)
 {
+    if(_composite_sprite)
+    {
+        _composite_render.set_z_order(*_composite_sprite, depth_z_orders * z);
+        return;
+    }
+
     if(!_body_sprite || !_eyes_sprite || !_top_sprite || !_bottom_sprite || !_hair_sprite)
     {
         return;
     }
 
-    _body_sprite->set_z_order(10 * z + 4);
-    _eyes_sprite->set_z_order(10 * z + 3);
-    _bottom_sprite->set_z_order(10 * z + 2);
-    _top_sprite->set_z_order(10 * z + 1);
-    _hair_sprite->set_z_order(10 * z);
+    const int z_order = depth_z_orders * z;
+    _body_render.set_z_order(*_body_sprite, z_order + 4);
+    _eyes_render.set_z_order(*_eyes_sprite, z_order + 3);
+    _bottom_render.set_z_order(*_bottom_sprite, z_order + 2);
+    _top_render.set_z_order(*_top_sprite, z_order + 1);
+    _hair_render.set_z_order(*_hair_sprite, z_order);
 }
 
 void PlayerSprite::set_visible(bool is_visible)
 {
-    if(!_body_sprite || !_eyes_sprite || !_top_sprite || !_bottom_sprite || !_hair_sprite)
+    _for_each_sprite([is_visible](bn::sprite_ptr& sprite, SpriteRenderState& render)
     {
-        return;
-    }
-
-    _body_sprite->set_visible(is_visible);
-    _eyes_sprite->set_visible(is_visible);
-    _bottom_sprite->set_visible(is_visible);
-    _top_sprite->set_visible(is_visible);
-    _hair_sprite->set_visible(is_visible);
+        render.set_visible(sprite, is_visible);
+    });
 }
 
 void PlayerSprite::rebuild(const bn::fixed_point& pos)
@@ -69,16 +85,10 @@ void PlayerSprite::rebuild(const bn::fixed_point& pos)
 
 void PlayerSprite::set_scale(int scale)
 {
-    if(!_body_sprite || !_eyes_sprite || !_top_sprite || !_bottom_sprite || !_hair_sprite)
+    _for_each_sprite([scale](bn::sprite_ptr& sprite, SpriteRenderState&)
     {
-        return;
-    }
-    
-    _body_sprite->set_scale(scale);
-    _eyes_sprite->set_scale(scale);
-    _top_sprite->set_scale(scale);
-    _bottom_sprite->set_scale(scale);
-    _hair_sprite->set_scale(scale);
+        sprite.set_scale(scale);
+    });
 }
 
 void PlayerSprite::attach_camera(const bn::camera_ptr& camera)
@@ -92,17 +102,10 @@ void PlayerSprite::attach_camera()
     if(!_camera)
         return;
 
-    auto& cam = _camera.value();
-    if(_body_sprite)
-        _body_sprite->set_camera(cam);
-    if(_eyes_sprite)
-        _eyes_sprite->set_camera(cam);
-    if(_top_sprite)
-        _top_sprite->set_camera(cam);
-    if(_bottom_sprite)
-        _bottom_sprite->set_camera(cam);
-    if(_hair_sprite)
-        _hair_sprite->set_camera(cam);
+    _for_each_sprite([this](bn::sprite_ptr& sprite, SpriteRenderState& render)
+    {
+        render.set_camera(sprite, _camera);
+    });
 }
 
 void PlayerSprite::detach_camera()
@@ -111,16 +114,10 @@ void PlayerSprite::detach_camera()
         return;
 
     _camera.reset();
-    if(_body_sprite)
-        _body_sprite->remove_camera();
-    if(_eyes_sprite)
-        _eyes_sprite->remove_camera();
-    if(_top_sprite)
-        _top_sprite->remove_camera();
-    if(_bottom_sprite)
-        _bottom_sprite->remove_camera();
-    if(_hair_sprite)
-        _hair_sprite->remove_camera();
+    _for_each_sprite([this](bn::sprite_ptr& sprite, SpriteRenderState& render)
+    {
+        render.set_camera(sprite, _camera);
+    });
 }
 
 void PlayerSprite::_rebuild_sprites(const bn::fixed_point& pos)
@@ -132,6 +129,42 @@ void PlayerSprite::_rebuild_sprites(const bn::fixed_point& pos)
     _top_item    = k_top_options[_appearance.top_index];
     _bottom_item = k_bottom_options[_appearance.bottom_index];
 
+    if(_mode == RenderMode::Composited)
+    {
+        // Apply color palette
+        _appearance.update(*_palette);
+
+        // Bank slots of every layer as character palette indices, back to
+        // front as the layers in _composite_tiles()
+        const bn::sprite_item* layer_items[composite_layers] = {
+            _body_item, _eyes_item, _bottom_item, _top_item, _hair_item
+        };
+
+        for(int layer = 0; layer < composite_layers; ++layer)
+        {
+            sprite_compositor::build_pair_table(k_character_bank_colors[character_sheet_bank(*layer_items[layer])],
+                                                _composite_pair_tables[layer]);
+        }
+
+        // Release the old frames before compositing the new layers
+        _composite_sprite.reset();
+        _composite_cache.clear();
+
+        _composite_sprite = bn::sprite_ptr::create(pos, _body_item->shape_size(), _composite_tiles(0), *_palette);
+        _composite_render.reset();
+        _composite_render.set_position(*_composite_sprite, pos);
+        _composite_render.set_frame(0);
+        attach_camera();
+        _composite_sprite->set_bg_priority(1);
+        return;
+    }
+
+    // Apply color palettes
+    for(int bank = 0; bank < _bank_palettes.size(); ++bank)
+    {
+        _appearance.update_bank(_bank_palettes[bank], k_character_bank_colors[bank]);
+    }
+
     // Create sprites at current position
     _body_sprite   = _body_item->create_sprite(pos);
     _eyes_sprite   = _eyes_item->create_sprite(pos);
@@ -139,18 +172,25 @@ void PlayerSprite::_rebuild_sprites(const bn::fixed_point& pos)
     _bottom_sprite = _bottom_item->create_sprite(pos);
     _hair_sprite   = _hair_item->create_sprite(pos);
 
-    // Apply color palette
-    _appearance.update(_palette);
+    // Each with the palette of its bank
+    _body_sprite->set_palette(_bank_palettes[character_sheet_bank(*_body_item)]);
+    _eyes_sprite->set_palette(_bank_palettes[character_sheet_bank(*_eyes_item)]);
+    _top_sprite->set_palette(_bank_palettes[character_sheet_bank(*_top_item)]);
+    _bottom_sprite->set_palette(_bank_palettes[character_sheet_bank(*_bottom_item)]);
+    _hair_sprite->set_palette(_bank_palettes[character_sheet_bank(*_hair_item)]);
+
+    // New sprites: nothing applied to them yet
+    _for_each_sprite([&pos](bn::sprite_ptr& sprite, SpriteRenderState& render)
+    {
+        render.reset();
+        render.set_position(sprite, pos);
+    });
 
     // Attach camera if it already exists
     attach_camera();
 
     // Set z-order (body -> eyes -> bottom -> top -> hair)
-    _body_sprite->set_z_order(4);
-    _eyes_sprite->set_z_order(3);
-    _bottom_sprite->set_z_order(2);
-    _top_sprite->set_z_order(1);
-    _hair_sprite->set_z_order(0);
+    set_z_order(0);
 
     // Set background order
     _body_sprite->set_bg_priority(1);
@@ -160,6 +200,69 @@ void PlayerSprite::_rebuild_sprites(const bn::fixed_point& pos)
     _hair_sprite->set_bg_priority(1);
 }
 
+const bn::sprite_tiles_ptr& PlayerSprite::_composite_tiles(int frame_index)
+{
+    ++_composite_clock;
+
+    for(CompositeFrame& frame : _composite_cache)
+    {
+        if(frame.frame_index == frame_index)
+        {
+            frame.last_use = _composite_clock;
+            return frame.tiles;
+        }
+    }
+
+    // 4bpp layers, 8bpp output (two tiles per layer tile)
+    const bn::sprite_tiles_item& body_tiles = _body_item->tiles_item();
+    const int tiles_count = body_tiles.tiles_count_per_graphic();
+    CompositeFrame* frame;
+
+    if(_composite_cache.full())
+    {
+        // The frame shown is the most recently used one, so it is never evicted
+        frame = &_composite_cache[0];
+
+        for(CompositeFrame& cached : _composite_cache)
+        {
+            if(cached.last_use < frame->last_use)
+            {
+                frame = &cached;
+            }
+        }
+    }
+    else
+    {
+        _composite_cache.push_back(CompositeFrame{
+            bn::sprite_tiles_ptr::allocate(tiles_count * 2, bn::bpp_mode::BPP_8), -1, 0 });
+        frame = &_composite_cache.back();
+    }
+
+    // Back to front (body -> eyes -> bottom -> top -> hair), as the z-orders
+    // of the layered sprites
+    const bn::tile* layers[composite_layers] = {
+        body_tiles.graphics_tiles_ref(frame_index).data(),
+        _eyes_item->tiles_item().graphics_tiles_ref(frame_index).data(),
+        _bottom_item->tiles_item().graphics_tiles_ref(frame_index).data(),
+        _top_item->tiles_item().graphics_tiles_ref(frame_index).data(),
+        _hair_item->tiles_item().graphics_tiles_ref(frame_index).data(),
+    };
+
+    const uint16_t* pair_tables[composite_layers];
+
+    for(int layer = 0; layer < composite_layers; ++layer)
+    {
+        pair_tables[layer] = _composite_pair_tables[layer];
+    }
+
+    bn::span<bn::tile> vram = *frame->tiles.vram();
+    sprite_compositor::composite_4bpp_to_8bpp(layers, pair_tables, composite_layers, tiles_count, vram.data());
+
+    frame->frame_index = frame_index;
+    frame->last_use = _composite_clock;
+    return frame->tiles;
+}
+
 // ---------------------------------------------------------------------------
 // Animation update logic
 // ---------------------------------------------------------------------------
@@ -174,12 +277,14 @@ void PlayerSprite::_rebuild_sprites(const bn::fixed_point& pos)
 //
 // There are 28 frames per direction row. You only have rows for
 // Down, Right, Up. Left uses the Right row with horizontal flip.
+// Periods are in frames, at the pace the animations had when the player was
+// updated twice per frame.
 //
 
 void PlayerSprite::_update_movement_animation(bool moving)
 {
-    constexpr int k_idle_period = 24; // frames between idle flips
-    constexpr int k_walk_period = 8;  // frames between walk steps
+    constexpr int k_idle_period = 12; // frames between idle flips
+    constexpr int k_walk_period = 4;  // frames between walk steps
 
     _moving = moving;
     ++_anim_counter;
@@ -213,7 +318,7 @@ void PlayerSprite::_update_attack_animation()
 {
     // Attack: 10 frames (10–19)
     constexpr int k_attack_frames = 10;
-    constexpr int k_attack_period = 4;  // frames per animation step
+    constexpr int k_attack_period = 2;  // frames per animation step
 
     ++_anim_counter;
     if(_anim_counter >= k_attack_period)
@@ -236,7 +341,7 @@ void PlayerSprite::_update_hurt_animation()
 {
     // Hurt: 4 frames (20–23)
     constexpr int k_hurt_frames = 4;
-    constexpr int k_hurt_period = 6;
+    constexpr int k_hurt_period = 3;
 
     ++_anim_counter;
     if(_anim_counter >= k_hurt_period)
@@ -259,7 +364,7 @@ void PlayerSprite::_update_death_animation()
 {
     // Death: 4 frames (24–27); stay on last frame
     constexpr int k_death_frames = 4;
-    constexpr int k_death_period = 8;
+    constexpr int k_death_period = 4;
 
     ++_anim_counter;
     if(_anim_counter >= k_death_period)
@@ -275,17 +380,14 @@ void PlayerSprite::_update_death_animation()
 
 void PlayerSprite::_sync_sprite(const bn::fixed_point& pos)
 {
-    if(!_body_sprite || !_eyes_sprite || !_top_sprite || !_bottom_sprite || !_hair_sprite)
+    if(!_composite_sprite &&
+       (!_body_sprite || !_eyes_sprite || !_top_sprite || !_bottom_sprite || !_hair_sprite))
     {
         return;
     }
 
     // Position
-    _body_sprite->set_position(pos);
-    _eyes_sprite->set_position(pos);
-    _top_sprite->set_position(pos);
-    _bottom_sprite->set_position(pos);
-    _hair_sprite->set_position(pos);
+    set_position(pos);
 
     // Apply camera if present
     attach_camera();
@@ -341,17 +443,29 @@ void PlayerSprite::_sync_sprite(const bn::fixed_point& pos)
 
     int frame_index = base_frame + rel_frame;
 
+    if(_composite_sprite)
+    {
+        // Composite only when the frame changes
+        if(_composite_render.set_frame(frame_index))
+        {
+            _composite_sprite->set_tiles(_composite_tiles(frame_index));
+        }
+
+        _composite_render.set_horizontal_flip(*_composite_sprite, flip_x);
+        return;
+    }
+
     // Apply tiles
-    _body_sprite->set_tiles(_body_item->tiles_item(), frame_index);
-    _eyes_sprite->set_tiles(_eyes_item->tiles_item(), frame_index);
-    _hair_sprite->set_tiles(_hair_item->tiles_item(), frame_index);
-    _bottom_sprite->set_tiles(_bottom_item->tiles_item(), frame_index);
-    _top_sprite->set_tiles(_top_item->tiles_item(), frame_index);
+    _body_render.set_tiles(*_body_sprite, _body_item->tiles_item(), frame_index);
+    _eyes_render.set_tiles(*_eyes_sprite, _eyes_item->tiles_item(), frame_index);
+    _hair_render.set_tiles(*_hair_sprite, _hair_item->tiles_item(), frame_index);
+    _bottom_render.set_tiles(*_bottom_sprite, _bottom_item->tiles_item(), frame_index);
+    _top_render.set_tiles(*_top_sprite, _top_item->tiles_item(), frame_index);
 
     // Apply horizontal flip for left-facing
-    _body_sprite->set_horizontal_flip(flip_x);
-    _eyes_sprite->set_horizontal_flip(flip_x);
-    _hair_sprite->set_horizontal_flip(flip_x);
-    _bottom_sprite->set_horizontal_flip(flip_x);
-    _top_sprite->set_horizontal_flip(flip_x);
+    _body_render.set_horizontal_flip(*_body_sprite, flip_x);
+    _eyes_render.set_horizontal_flip(*_eyes_sprite, flip_x);
+    _hair_render.set_horizontal_flip(*_hair_sprite, flip_x);
+    _bottom_render.set_horizontal_flip(*_bottom_sprite, flip_x);
+    _top_render.set_horizontal_flip(*_top_sprite, flip_x);
 }
@@ -0,0 +1,54 @@
+#include "sprite_compositor.h"
+
+#include "bn_assert.h"
+
+namespace
+{
+    // 0xFF in every byte of pixels which isn't 0, 0x00 in the others
+    [[nodiscard]] inline uint32_t opaque_mask_8bpp(uint32_t pixels)
+    {
+        const uint32_t high_bits = (((pixels & 0x7F7F7F7F) + 0x7F7F7F7F) | pixels) & 0x80808080;
+        return (high_bits >> 7) * 0xFF;
+    }
+}
+
+namespace sprite_compositor
+{
+    void composite_4bpp_to_8bpp(const bn::tile* const* layers, const uint16_t* const* pair_tables,
+                                int layer_count, int tiles_count, bn::tile* output)
+    {
+        BN_ASSERT(layer_count > 0 && layer_count <= max_layers, "Invalid layer count: ", layer_count);
+
+        constexpr int words_per_tile = sizeof(bn::tile) / sizeof(uint32_t);
+
+        uint32_t* destination = output->data;
+        const int words = tiles_count * words_per_tile;
+
+        // A 4bpp word is a row of 8 pixels, two 8bpp words
+        for(int word = 0; word < words; ++word)
+        {
+            uint32_t left = 0;
+            uint32_t right = 0;
+
+            for(int layer = 0; layer < layer_count; ++layer)
+            {
+                const uint32_t pixels = layers[layer]->data[word];
+
+                if(!pixels)
+                {
+                    continue;
+                }
+
+                const uint16_t* pair_table = pair_tables[layer];
+                const uint32_t layer_left = pair_table[pixels & 0xFF] | (uint32_t(pair_table[(pixels >> 8) & 0xFF]) << 16);
+                const uint32_t layer_right = pair_table[(pixels >> 16) & 0xFF] | (uint32_t(pair_table[pixels >> 24]) << 16);
+
+                left = (left & ~opaque_mask_8bpp(layer_left)) | layer_left;
+                right = (right & ~opaque_mask_8bpp(layer_right)) | layer_right;
+            }
+
+            destination[word * 2] = left;
+            destination[word * 2 + 1] = right;
+        }
+    }
+}
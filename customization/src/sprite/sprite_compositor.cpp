@@ -0,0 +1,12 @@
+#include "sprite_compositor.h"
+
+namespace sprite_compositor
+{
+    void build_pair_table(const uint8_t* color_map, uint16_t* pair_table)
+    {
+        for(int pair = 0; pair < pair_table_size; ++pair)
+        {
+            pair_table[pair] = uint16_t(color_map[pair & 0xF] | (color_map[pair >> 4] << 8));
+        }
+    }
+}
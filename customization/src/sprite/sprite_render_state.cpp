@@ -0,0 +1,14 @@
+// ---------------------------------------------------------------------------
+// sprite_render_state.cpp
+// ---------------------------------------------------------------------------
+
+#include "sprite_render_state.h"
+
+int SpriteRenderState::_issued_updates = 0;
+int SpriteRenderState::_skipped_updates = 0;
+
+void SpriteRenderState::reset_counters()
+{
+    _issued_updates = 0;
+    _skipped_updates = 0;
+}
@@ -0,0 +1,54 @@
+#include "room_codec.h"
+
+#include "bn_assert.h"
+
+namespace room_codec
+{
+
+LayerDecoder::LayerDecoder(const RoomMapData& map, int layer, bn::regular_bg_map_cell* cells) :
+    _map(&map),
+    _output(cells),
+    _layer(layer),
+    _row_count(k_row_count)
+{
+    BN_ASSERT(!map.streamed(), "Streamed rooms are not decoded");
+}
+
+void LayerDecoder::decode(int max_cells)
+{
+    constexpr int screenblock_rows = ROOM_CELLS / 4 / k_row_cells;
+
+    while(max_cells > 0 && _row < _row_count)
+    {
+        // Output row -> room tile row/column of its first cell
+        const int screenblock = _row / screenblock_rows;
+        const int ty = (screenblock / 2) * screenblock_rows + _row % screenblock_rows;
+        const int tx = (screenblock % 2) * k_row_cells;
+
+        const int quadrant = (ty % METATILE_SIZE) * METATILE_SIZE;
+        const uint8_t* metatiles = _map->metatiles + (ty / METATILE_SIZE) * (ROOM_WIDTH / METATILE_SIZE) +
+                tx / METATILE_SIZE;
+        bn::regular_bg_map_cell* output = _output + _row * k_row_cells;
+
+        for(int i = 0; i < k_row_cells / METATILE_SIZE; ++i)
+        {
+            const uint16_t* cells = _map->dictionary[metatiles[i]].cells[_layer] + quadrant;
+            output[0] = cells[0];
+            output[1] = cells[1];
+            output += METATILE_SIZE;
+        }
+
+        ++_row;
+        max_cells -= k_row_cells;
+    }
+}
+
+void decode_layer(const RoomMapData& map, int layer, bn::regular_bg_map_cell* cells)
+{
+    LayerDecoder decoder(map, layer, cells);
+    decoder.decode(ROOM_CELLS);
+
+    BN_ASSERT(decoder.done(), "Invalid room layer size");
+}
+
+}
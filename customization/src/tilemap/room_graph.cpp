@@ -0,0 +1,139 @@
+#include "room_graph.h"
+
+#include "bn_assert.h"
+#include "bn_math.h"
+
+namespace
+{
+    int manhattan(const bn::fixed_point& a, const bn::fixed_point& b)
+    {
+        return bn::abs(a.x().integer() - b.x().integer()) + bn::abs(a.y().integer() - b.y().integer());
+    }
+}
+
+RoomGraph::RoomGraph()
+{
+    int door_count = 0;
+
+    for(int room = 0; room < ROOM_COUNT; ++room)
+    {
+        BN_ASSERT(g_rooms[room].door_count <= MAX_DOORS_PER_ROOM, "Too many doors in room ", room);
+
+        _first_door[room] = door_count;
+        door_count += g_rooms[room].door_count;
+    }
+
+    // Going through a door arrives in its target room
+    for(int room = 0; room < ROOM_COUNT; ++room)
+    {
+        const RoomData& data = g_rooms[room];
+
+        for(int door = 0; door < data.door_count; ++door)
+        {
+            const DoorData& dd = data.doors[door];
+            int* distances = _distances[_first_door[room] + door];
+
+            for(int to = 0; to < ROOM_COUNT; ++to)
+            {
+                distances[to] = _valid_door(dd) && static_cast<int>(dd.target_room) == to ? 0 : unreachable;
+            }
+        }
+    }
+
+    // Relax door -> door hops until nothing changes (Bellman-Ford)
+    bool changed = true;
+
+    for(int pass = 0; changed && pass < door_count; ++pass)
+    {
+        changed = false;
+
+        for(int room = 0; room < ROOM_COUNT; ++room)
+        {
+            const RoomData& data = g_rooms[room];
+
+            for(int door = 0; door < data.door_count; ++door)
+            {
+                const DoorData& dd = data.doors[door];
+
+                if(!_valid_door(dd))
+                {
+                    continue;
+                }
+
+                const RoomId next_room = dd.target_room;
+                const RoomData& next_data = g_rooms[static_cast<int>(next_room)];
+                const bn::fixed_point spawn_pos(dd.target_x_px, dd.target_y_px);
+                int* distances = _distances[_first_door[room] + door];
+
+                for(int next_door = 0; next_door < next_data.door_count; ++next_door)
+                {
+                    if(!_valid_door(next_data.doors[next_door]))
+                    {
+                        continue;
+                    }
+
+                    const int walk = manhattan(spawn_pos, door_center(next_room, next_door));
+                    const int* next_distances = _distances[_first_door[static_cast<int>(next_room)] + next_door];
+
+                    for(int to = 0; to < ROOM_COUNT; ++to)
+                    {
+                        if(next_distances[to] != unreachable && walk + next_distances[to] < distances[to])
+                        {
+                            distances[to] = walk + next_distances[to];
+                            changed = true;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+bn::optional<RoomGraph::Route> RoomGraph::route(RoomId from, const bn::fixed_point& pos, RoomId to) const
+{
+    bn::optional<Route> best;
+
+    if(from == to)
+    {
+        return best;
+    }
+
+    const RoomData& data = g_rooms[static_cast<int>(from)];
+
+    for(int door = 0; door < data.door_count; ++door)
+    {
+        const int remaining = distance(from, door, to);
+
+        if(remaining == unreachable)
+        {
+            continue;
+        }
+
+        const int door_distance = manhattan(pos, door_center(from, door));
+        const int total = door_distance + remaining;
+
+        if(!best || total < best->distance)
+        {
+            best = Route{ door, door_distance, total };
+        }
+    }
+
+    return best;
+}
+
+int RoomGraph::distance(RoomId from, int door, RoomId to) const
+{
+    return _distances[_first_door[static_cast<int>(from)] + door][static_cast<int>(to)];
+}
+
+bn::fixed_point RoomGraph::door_center(RoomId room, int door)
+{
+    const RoomData& data = g_rooms[static_cast<int>(room)];
+    const DoorData& dd = data.doors[door];
+
+    const int left_px = -data.map->width * TILE_SIZE / 2;
+    const int top_px  = -data.map->height * TILE_SIZE / 2;
+
+    return bn::fixed_point(left_px + dd.tile_x * TILE_SIZE + (dd.width_tiles * TILE_SIZE) / 2,
+                           top_px + dd.tile_y * TILE_SIZE + TILE_SIZE / 2);
+}
@@ -2,110 +2,302 @@
 
 #include "bn_regular_bg_tiles_items_tiles.h"
 #include "bn_bg_palette_items_palette.h"
-#include "bn_regular_bg_item.h"
-#include "bn_regular_bg_map_cell_info.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_memory.h"
 #include "bn_math.h"
+#include "bn_utility.h"
+#include "bn_timer.h"
+#include "bn_log.h"
+#include "bn_assert.h"
+
+namespace
+{
+    // Index of a regular room tile in its cells (screenblock / VRAM order)
+    int room_cell_index(int tx, int ty)
+    {
+        const int screenblock = (ty / STREAM_SIZE) * (ROOM_WIDTH / STREAM_SIZE) + tx / STREAM_SIZE;
+        return screenblock * STREAM_CELLS + (ty % STREAM_SIZE) * STREAM_SIZE + tx % STREAM_SIZE;
+    }
+}
 
 WorldMap::WorldMap(RoomId start_room) : _current_room(start_room)
 {
-    _build_room(_current_room);
+    begin_room_load(start_room);
+    commit_room_load();
 }
 
-void WorldMap::_fill_layer(const uint8_t* source, BgLayer& layer)
+int WorldMap::_find_slot(RoomId room) const
 {
-    const int half_width  = ROOM_WIDTH  / 2;
-    const int half_height = ROOM_HEIGHT / 2;
-    constexpr int empty_tile_index = 40;
-    int j = 0;
+    for(int index = 0; index < room_cache_slots; ++index)
+    {
+        if(_slots[index].room && *_slots[index].room == room)
+        {
+            return index;
+        }
+    }
+
+    return -1;
+}
 
-    auto fill_quad = [&](int y_start, int y_end, int x_start, int x_end)
+bool WorldMap::_is_door_target(RoomId room) const
+{
+    const RoomData& data = g_rooms[static_cast<int>(_current_room)];
+
+    for(int i = 0; i < data.door_count; ++i)
     {
-        for(int y = y_start; y < y_end; ++y)
+        if(data.doors[i].target_room == room)
         {
-            for(int x = x_start; x < x_end; ++x, ++j)
-            {
-                const int index = y * ROOM_WIDTH + x;
-                bn::regular_bg_map_cell_info cell_info;
-                const int src_value = source[index];
+            return true;
+        }
+    }
 
-                if(src_value == 0)
-                {
-                    cell_info.set_tile_index(empty_tile_index);
-                }
-                else
-                {
-                    cell_info.set_tile_index(src_value - 1);
-                }
+    return false;
+}
+
+// Pick a slot for room and start decoding it there. Never touches the visible
+// slot or the one being loaded; prefers empty slots, then rooms that are not
+// behind a door of the current room.
+int WorldMap::_claim_slot(RoomId room, bool evict_door_targets)
+{
+    const int loading_slot = _pending_load ? _pending_load->slot : -1;
+    int result = -1;
+
+    for(int index = 0; index < room_cache_slots; ++index)
+    {
+        if(index == _front_slot || index == loading_slot)
+        {
+            continue;
+        }
+
+        const RoomSlot& slot = _slots[index];
+
+        if(!slot.room)
+        {
+            result = index;
+            break;
+        }
+
+        if(!_is_door_target(*slot.room))
+        {
+            result = index;
+        }
+        else if(evict_door_targets && result < 0)
+        {
+            result = index;
+        }
+    }
+
+    if(result >= 0)
+    {
+        const RoomMapData& map = *g_rooms[static_cast<int>(room)].map;
+        RoomSlot& slot = _slots[result];
+        slot.room = room;
+        slot.decoders[0] = room_codec::LayerDecoder(map, 0, slot.layers[0].cells);
+        slot.decoders[1] = room_codec::LayerDecoder(map, 1, slot.layers[1].cells);
+    }
+
+    return result;
+}
+
+// Decode chunks of a slot until budget_ticks would be exceeded, returns the
+// ticks spent. Always makes progress, then only starts another chunk if one
+// more chunk of the same cost still fits in the budget.
+int WorldMap::_decode_slot(RoomSlot& slot, int budget_ticks)
+{
+    bn::timer budget_timer;
+    int elapsed_ticks = 0;
+    int chunk_ticks = 0;
+
+    do
+    {
+        room_codec::LayerDecoder& decoder = slot.decoders[0].done() ? slot.decoders[1] : slot.decoders[0];
+
+        if(decoder.done())
+        {
+            break;
+        }
+
+        decoder.decode(room_load_chunk_cells);
+
+        const int now_ticks = budget_timer.elapsed_ticks();
+        chunk_ticks = bn::max(chunk_ticks, now_ticks - elapsed_ticks);
+        elapsed_ticks = now_ticks;
+    }
+    while(elapsed_ticks + chunk_ticks <= budget_ticks);
+
+    return elapsed_ticks;
+}
+
+void WorldMap::begin_room_load(RoomId room)
+{
+    RoomLoad load;
+    load.room = room;
+
+    // Streamed rooms are expanded from ROM as the camera moves instead
+    if(!g_rooms[static_cast<int>(room)].map->streamed())
+    {
+        load.slot = _find_slot(room);
+
+        if(load.slot >= 0)
+        {
+            load.cached = _slots[load.slot].decoded();
+        }
+        else
+        {
+            // Decode into a slot the visible room is not using
+            load.slot = _claim_slot(room, true);
+            BN_ASSERT(load.slot >= 0, "No free room cache slot");
+        }
+    }
+
+    _pending_load = load;
+}
+
+bool WorldMap::update_room_load(int budget_ticks)
+{
+    BN_ASSERT(_pending_load, "No room load in progress");
+
+    RoomLoad& load = *_pending_load;
+    ++load.frames;
+
+    if(load.slot < 0)
+    {
+        return true;
+    }
+
+    RoomSlot& slot = _slots[load.slot];
+    load.ticks += _decode_slot(slot, budget_ticks);
+    return slot.decoded();
+}
+
+void WorldMap::update_prefetch(int budget_ticks)
+{
+    // Door transitions have priority
+    if(_pending_load)
+    {
+        return;
+    }
 
-                layer.cells[j] = cell_info.cell();
+    const RoomData& data = g_rooms[static_cast<int>(_current_room)];
+
+    // One room at a time, in door order
+    for(int i = 0; i < data.door_count; ++i)
+    {
+        const RoomId target = data.doors[i].target_room;
+
+        if(target == _current_room || g_rooms[static_cast<int>(target)].map->streamed())
+        {
+            continue;
+        }
+
+        int slot = _find_slot(target);
+
+        if(slot < 0)
+        {
+            // Only evict rooms the player cannot reach from here
+            slot = _claim_slot(target, false);
+
+            if(slot < 0)
+            {
+                return;
             }
         }
-    };
 
-    // Q1: top-left
-    fill_quad(0,           half_height,     0,           half_width);
-    // Q2: top-right
-    fill_quad(0,           half_height,     half_width,  ROOM_WIDTH);
-    // Q3: bottom-left
-    fill_quad(half_height, ROOM_HEIGHT,     0,           half_width);
-    // Q4: bottom-right
-    fill_quad(half_height, ROOM_HEIGHT,     half_width,  ROOM_WIDTH);
+        if(!_slots[slot].decoded())
+        {
+            _decode_slot(_slots[slot], budget_ticks);
+            return;
+        }
+    }
 }
 
-void WorldMap::_build_room(RoomId room)
+void WorldMap::commit_room_load()
 {
-    _current_room = room;
+    BN_ASSERT(_pending_load, "No room load in progress");
+
+    RoomLoad& load = *_pending_load;
+
+    // Finish whatever the per-frame budget did not cover
+    if(load.slot >= 0)
+    {
+        bn::timer finish_timer;
+        RoomSlot& slot = _slots[load.slot];
+        slot.decoders[0].decode(ROOM_CELLS);
+        slot.decoders[1].decode(ROOM_CELLS);
+        load.ticks += finish_timer.elapsed_ticks();
+    }
+
+    const RoomId room = load.room;
     const RoomData& data = g_rooms[static_cast<int>(room)];
+    const RoomMapData& map = *data.map;
+
+    BN_LOG("Room ", static_cast<int>(room), load.cached ? " (prefetched)" : "", " decoded in ", load.ticks,
+           " ticks over ", load.frames, " frames from ", (map.width / METATILE_SIZE) * (map.height / METATILE_SIZE),
+           " ROM bytes");
+
+    _current_room = room;
+    _map = &map;
+    ++_collision_revision;
+    _front_slot = load.slot;
+    _stream_valid = false;
+    _pending_load.reset();
+
+    // Bring back the edits made the last time the player was here
+    _apply_edits();
+
+    // Regular rooms show their cache slot, streamed rooms their cell ring
+    const int map_width = _front_slot >= 0 ? ROOM_WIDTH : STREAM_SIZE;
+
+    // The background is centered on its map: shift it so its left edge matches
+    // the room's left edge (the ring of streamed rooms wraps from there)
+    const int bg_x = (map_width - map.width) * TILE_SIZE / 2;
+    const int bg_y = (map_width - map.height) * TILE_SIZE / 2;
+
+    // Maps are allocated in VRAM and written directly, so tile edits only
+    // copy the cells they changed
+    _layer1_bg = bn::nullopt;
+    _layer2_bg = bn::nullopt;
+    _layer_maps[0] = bn::nullopt;
+    _layer_maps[1] = bn::nullopt;
+
+    const bn::regular_bg_tiles_ptr tiles = bn::regular_bg_tiles_items::tiles.create_tiles();
+    const bn::bg_palette_ptr palette = bn::bg_palette_items::palette.create_palette();
+    _layer_maps[0] = bn::regular_bg_map_ptr::allocate(bn::size(map_width, map_width), tiles, palette);
+    _layer_maps[1] = bn::regular_bg_map_ptr::allocate(bn::size(map_width, map_width), tiles, palette);
 
     // -----------------------------
     // Layer 1: ground / base
     // -----------------------------
-    _fill_layer(data.layer1, _layer1_map);
-
-    _layer1_bg = bn::nullopt; // reset background layer 1
-
-    bn::regular_bg_item bg_item1(
-        bn::regular_bg_tiles_items::tiles,
-        bn::bg_palette_items::palette,
-        _layer1_map.map_item);
-
-    _layer1_bg = bg_item1.create_bg(0, 0);
+    _layer1_bg = bn::regular_bg_ptr::create(bg_x, bg_y, *_layer_maps[0]);
     _layer1_bg->set_priority(2);   // behind layer 2 & sprites
 
     // -----------------------------
     // Layer 2: decorations / above
     // -----------------------------
-    _fill_layer(data.layer2, _layer2_map);
-
-    _layer2_bg = bn::nullopt; // reset background layer 2
-
-    bn::regular_bg_item bg_item2(
-        bn::regular_bg_tiles_items::tiles,
-        bn::bg_palette_items::palette,
-        _layer2_map.map_item);
-
-    _layer2_bg = bg_item2.create_bg(0, 0);
+    _layer2_bg = bn::regular_bg_ptr::create(bg_x, bg_y, *_layer_maps[1]);
     _layer2_bg->set_priority(0);   // in front of layer 1, behind sprites
 
-    // -----------------------------
-    // Collision layer
-    // -----------------------------
-    for(int i = 0; i < ROOM_CELLS; ++i)
+    // Regular rooms: copy the whole slot in
+    for(int layer = 0; layer < 2; ++layer)
     {
-        // 0 = empty, non-zero = solid
-        _collision_cells[i] = data.collision[i];
+        _dirty_begin[layer] = 0;
+        _dirty_end[layer] = ROOM_CELLS;
     }
 
+    _flush_edits();
+
+    // Streamed rooms: fill the ring around the camera
+    _update_stream();
+
     // -----------------------------
     // Doors for this room (from RoomData::doors)
     // -----------------------------
     _doors.clear();
 
-    const int map_px_w = ROOM_WIDTH * TILE_SIZE;
-    const int map_px_h = ROOM_HEIGHT * TILE_SIZE;
-
-    const int left_px = -map_px_w / 2;
-    const int top_px  = -map_px_h / 2;
+    const int left_px = -pixel_width() / 2;
+    const int top_px  = -pixel_height() / 2;
 
     for(int i = 0; i < data.door_count; ++i)
     {
@@ -172,68 +364,446 @@ void WorldMap::set_camera(const bn::camera_ptr& camera)
     {
         door.set_camera(_camera);
     }
+
+    _update_stream();
 }
 
-// Map is centered at (0,0).
-// World X/Y in pixels; convert to tile coordinates and look up collision.
-bool WorldMap::is_solid(const bn::fixed_point& world_pos) const
+bn::fixed_point WorldMap::tile_center(int tx, int ty) const
 {
-    int map_px_w = ROOM_WIDTH * TILE_SIZE;
-    int map_px_h = ROOM_HEIGHT * TILE_SIZE;
+    const int left_px = -pixel_width() / 2;
+    const int top_px  = -pixel_height() / 2;
 
-    int left_px = -map_px_w / 2;
-    int top_px  = -map_px_h / 2;
+    return bn::fixed_point(left_px + tx * TILE_SIZE + TILE_SIZE / 2, top_px + ty * TILE_SIZE + TILE_SIZE / 2);
+}
 
-    int x_px = world_pos.x().integer();
-    int y_px = world_pos.y().integer();
+void WorldMap::change_room(RoomId room)
+{
+    if(room == _current_room)
+        return;
 
-    int tx = (x_px - left_px) / TILE_SIZE;
-    int ty = (y_px - top_px) / TILE_SIZE;
+    begin_room_load(room);
+    commit_room_load();
+}
 
-    if(tx < 0 || tx >= ROOM_WIDTH || ty < 0 || ty >= ROOM_HEIGHT)
+bn::optional<DoorTarget> WorldMap::check_door_collision(const bn::fixed_point& player_pos) const
+{
+    for(const Door& door : _doors)
     {
-        // Outside the map = solid wall
-        return true;
+        if(door.contains(player_pos))
+        {
+            return door.target();
+        }
+    }
+    return bn::nullopt;
+}
+
+void WorldMap::update()
+{
+    for(Door& door : _doors)
+    {
+        door.update();
     }
 
-    int index = ty * ROOM_WIDTH + tx;
-    return _collision_cells[index] != 0;
+    _flush_edits();
+    _update_stream();
 }
 
-int WorldMap::pixel_width() const
+void WorldMap::set_tile(int layer, int tx, int ty, int tile)
 {
-    return ROOM_WIDTH * TILE_SIZE;
+    BN_ASSERT(layer == 0 || layer == 1, "Invalid layer: ", layer);
+    BN_ASSERT(tx >= 0 && tx < _map->width && ty >= 0 && ty < _map->height, "Tile out of the room: ", tx, ", ", ty);
+    BN_ASSERT(tile >= 0 && tile < 1024, "Invalid tile index: ", tile);
+
+    const bn::regular_bg_map_cell cell = tile;
+    _record_edit(layer, tx, ty, cell);
+    _show_cell(layer, tx, ty, cell);
 }
 
-int WorldMap::pixel_height() const
+void WorldMap::set_solid(int tx, int ty, bool solid)
 {
-    return ROOM_HEIGHT * TILE_SIZE;
+    BN_ASSERT(tx >= 0 && tx < _map->width && ty >= 0 && ty < _map->height, "Tile out of the room: ", tx, ", ", ty);
+
+    TileAttributes attributes = tile_attributes_at(tx, ty);
+
+    if(solid)
+    {
+        attributes |= TILE_SOLID;
+    }
+    else
+    {
+        attributes &= ~TILE_SOLID;
+    }
+
+    _record_edit(attributes_edit_layer, tx, ty, attributes);
+    ++_collision_revision;
 }
 
-void WorldMap::change_room(RoomId room)
+// Keep the last value of every edited cell / attribute of every room (and the
+// attribute lookup of the current room in step)
+void WorldMap::_record_edit(int layer, int tx, int ty, int value)
 {
-    if(room == _current_room)
+    // Back to the room data: nothing to restore later
+    const bool original = value == _room_value(_current_room, layer, tx, ty);
+    int index = 0;
+
+    while(index < _edits.size())
+    {
+        const TileEdit& edit = _edits[index];
+
+        if(edit.room == _current_room && edit.tx == tx && edit.ty == ty && edit.layer == layer)
+        {
+            break;
+        }
+
+        ++index;
+    }
+
+    if(index < _edits.size())
+    {
+        if(original)
+        {
+            _forget_edit(index);
+        }
+        else
+        {
+            _edits[index].value = value;
+        }
+    }
+    else if(!original)
+    {
+        if(_edits.full())
+        {
+            _forget_oldest_edit();
+        }
+
+        _edits.push_back(TileEdit{ _current_room, uint16_t(tx), uint16_t(ty), uint8_t(layer), uint16_t(value) });
+    }
+
+    if(layer == attributes_edit_layer && !original)
+    {
+        _set_attribute_edit(ty * _map->width + tx, TileAttributes(value));
+    }
+}
+
+// Map cell or attributes of a tile of a room in its room data
+int WorldMap::_room_value(RoomId room, int layer, int tx, int ty) const
+{
+    const Metatile& metatile = g_rooms[static_cast<int>(room)].map->metatile_at(tx, ty);
+    const int quadrant = (ty % METATILE_SIZE) * METATILE_SIZE + tx % METATILE_SIZE;
+
+    return layer == attributes_edit_layer ? metatile.attributes[quadrant] : metatile.cells[layer][quadrant];
+}
+
+// Drop an edit and undo it: the attribute lookup of the current room loses it,
+// and the cell gets its room data back wherever it is held (the backgrounds of
+// the current room, or the cache slot of another room, which is shown again
+// as is when the room is entered)
+void WorldMap::_forget_edit(int index)
+{
+    const TileEdit& edit = _edits[index];
+
+    if(edit.layer == attributes_edit_layer)
+    {
+        if(edit.room == _current_room)
+        {
+            _remove_attribute_edit(edit.ty * _map->width + edit.tx);
+        }
+    }
+    else
+    {
+        const bn::regular_bg_map_cell cell = _room_value(edit.room, edit.layer, edit.tx, edit.ty);
+
+        if(edit.room == _current_room)
+        {
+            _show_cell(edit.layer, edit.tx, edit.ty, cell);
+        }
+        else if(const int slot = _find_slot(edit.room); slot >= 0)
+        {
+            _slots[slot].layers[edit.layer].cells[room_cell_index(edit.tx, edit.ty)] = cell;
+        }
+    }
+
+    _edits.erase(_edits.begin() + index);
+}
+
+// Write a cell of the current room where it is shown
+void WorldMap::_show_cell(int layer, int tx, int ty, bn::regular_bg_map_cell cell)
+{
+    if(_front_slot >= 0)
+    {
+        // Copied to VRAM by the next update(), with the other edits of the frame
+        const int index = room_cell_index(tx, ty);
+        _slots[_front_slot].layers[layer].cells[index] = cell;
+        _dirty_begin[layer] = bn::min(_dirty_begin[layer], index);
+        _dirty_end[layer] = bn::max(_dirty_end[layer], index + 1);
+    }
+    else if(_stream_valid && tx >= _stream_origin.x() && tx < _stream_origin.x() + STREAM_SIZE &&
+            ty >= _stream_origin.y() && ty < _stream_origin.y() + STREAM_SIZE)
+    {
+        // Streamed rooms have no copy of the cells in RAM: write the ring if
+        // the tile is in it, otherwise it is written when it scrolls in
+        _layer_maps[layer]->vram()->data()[(ty % STREAM_SIZE) * STREAM_SIZE + tx % STREAM_SIZE] = cell;
+    }
+}
+
+// No room left for a new edit: forget the oldest edit of another room, or
+// else the oldest one of the current room
+void WorldMap::_forget_oldest_edit()
+{
+    int index = 0;
+
+    for(int other = 0; other < _edits.size(); ++other)
+    {
+        if(_edits[other].room != _current_room)
+        {
+            index = other;
+            break;
+        }
+    }
+
+    BN_LOG("Too many tile edits, forgetting one of room ", static_cast<int>(_edits[index].room));
+    _forget_edit(index);
+}
+
+// Edits of the room just made current: attributes go to the sorted lookup,
+// cells of regular rooms are written over the freshly decoded slot
+void WorldMap::_apply_edits()
+{
+    _attribute_edits.clear();
+
+    for(const TileEdit& edit : _edits)
+    {
+        if(edit.room != _current_room)
+        {
+            continue;
+        }
+
+        if(edit.layer == attributes_edit_layer)
+        {
+            _set_attribute_edit(edit.ty * _map->width + edit.tx, TileAttributes(edit.value));
+        }
+        else if(_front_slot >= 0)
+        {
+            _slots[_front_slot].layers[edit.layer].cells[room_cell_index(edit.tx, edit.ty)] = edit.value;
+        }
+    }
+}
+
+void WorldMap::_set_attribute_edit(int tile, TileAttributes attributes)
+{
+    const int index = _attribute_edit_index(tile);
+
+    if(index < _attribute_edits.size() && _attribute_edits[index].tile == tile)
+    {
+        _attribute_edits[index].attributes = attributes;
         return;
+    }
+
+    BN_ASSERT(!_attribute_edits.full(), "Too many attribute edits");
+
+    _attribute_edits.push_back(AttributeEdit{ tile, attributes });
 
-    _build_room(room);
+    for(int moved = _attribute_edits.size() - 1; moved > index; --moved)
+    {
+        bn::swap(_attribute_edits[moved], _attribute_edits[moved - 1]);
+    }
 }
 
-bn::optional<DoorTarget> WorldMap::check_door_collision(const bn::fixed_point& player_pos) const
+void WorldMap::_remove_attribute_edit(int tile)
 {
-    for(const Door& door : _doors)
+    const int index = _attribute_edit_index(tile);
+
+    if(index < _attribute_edits.size() && _attribute_edits[index].tile == tile)
     {
-        if(door.contains(player_pos))
+        _attribute_edits.erase(_attribute_edits.begin() + index);
+    }
+}
+
+// Copy the edited range of the visible slot to VRAM, once per frame
+void WorldMap::_flush_edits()
+{
+    if(_front_slot < 0)
+    {
+        return;
+    }
+
+    for(int layer = 0; layer < 2; ++layer)
+    {
+        const int begin = _dirty_begin[layer];
+        const int end = _dirty_end[layer];
+
+        if(begin < end)
         {
-            return door.target();
+            const bn::regular_bg_map_cell* cells = _slots[_front_slot].layers[layer].cells;
+            bn::regular_bg_map_cell* vram = _layer_maps[layer]->vram()->data();
+            bn::memory::copy(cells[begin], end - begin, vram[begin]);
+
+            _dirty_begin[layer] = ROOM_CELLS;
+            _dirty_end[layer] = 0;
         }
     }
-    return bn::nullopt;
 }
 
-void WorldMap::update()
+// Keep the ring of a streamed room centered on the camera, writing only the
+// rows and columns that scrolled into it since the last call.
+void WorldMap::_update_stream()
 {
-    for(Door& door : _doors)
+    if(!_map->streamed() || !_layer_maps[0] || !_layer_maps[1])
     {
-        door.update();
+        return;
+    }
+
+    bn::point center(_map->width / 2, _map->height / 2);
+
+    if(_camera)
+    {
+        center = world_to_tile(_camera->position());
+    }
+
+    const bn::point origin(
+        bn::clamp(center.x() - STREAM_SIZE / 2, 0, _map->width - STREAM_SIZE),
+        bn::clamp(center.y() - STREAM_SIZE / 2, 0, _map->height - STREAM_SIZE));
+
+    if(_stream_valid && origin == _stream_origin)
+    {
+        return;
+    }
+
+    const int dx = origin.x() - _stream_origin.x();
+    const int dy = origin.y() - _stream_origin.y();
+    _stream_origin = origin;
+
+    if(!_stream_valid || bn::abs(dx) >= STREAM_SIZE || bn::abs(dy) >= STREAM_SIZE)
+    {
+        // First fill or a jump (teleport): rewrite the whole ring
+        _stream_valid = true;
+
+        for(int ty = origin.y(); ty < origin.y() + STREAM_SIZE; ++ty)
+        {
+            _stream_row(ty);
+        }
+    }
+    else
+    {
+        // Columns entering on the left or right
+        const int first_column = dx > 0 ? origin.x() + STREAM_SIZE - dx : origin.x();
+
+        for(int tx = first_column; tx < first_column + bn::abs(dx); ++tx)
+        {
+            _stream_column(tx);
+        }
+
+        // Rows entering at the top or bottom
+        const int first_row = dy > 0 ? origin.y() + STREAM_SIZE - dy : origin.y();
+
+        for(int ty = first_row; ty < first_row + bn::abs(dy); ++ty)
+        {
+            _stream_row(ty);
+        }
+    }
+}
+
+void WorldMap::_stream_row(int ty)
+{
+    bn::regular_bg_map_cell* cells1 = _layer_maps[0]->vram()->data() + (ty % STREAM_SIZE) * STREAM_SIZE;
+    bn::regular_bg_map_cell* cells2 = _layer_maps[1]->vram()->data() + (ty % STREAM_SIZE) * STREAM_SIZE;
+    const int quadrant_y = (ty % METATILE_SIZE) * METATILE_SIZE;
+
+    for(int tx = _stream_origin.x(); tx < _stream_origin.x() + STREAM_SIZE; ++tx)
+    {
+        const Metatile& metatile = _map->metatile_at(tx, ty);
+        const int quadrant = quadrant_y + tx % METATILE_SIZE;
+        const int cell = tx % STREAM_SIZE;
+        cells1[cell] = metatile.cells[0][quadrant];
+        cells2[cell] = metatile.cells[1][quadrant];
+    }
+
+    _stream_edits(_stream_origin.x(), ty, _stream_origin.x() + STREAM_SIZE - 1, ty);
+}
+
+void WorldMap::_stream_column(int tx)
+{
+    bn::regular_bg_map_cell* cells1 = _layer_maps[0]->vram()->data();
+    bn::regular_bg_map_cell* cells2 = _layer_maps[1]->vram()->data();
+    const int cell_x = tx % STREAM_SIZE;
+    const int quadrant_x = tx % METATILE_SIZE;
+
+    for(int ty = _stream_origin.y(); ty < _stream_origin.y() + STREAM_SIZE; ++ty)
+    {
+        const Metatile& metatile = _map->metatile_at(tx, ty);
+        const int quadrant = (ty % METATILE_SIZE) * METATILE_SIZE + quadrant_x;
+        const int cell = (ty % STREAM_SIZE) * STREAM_SIZE + cell_x;
+        cells1[cell] = metatile.cells[0][quadrant];
+        cells2[cell] = metatile.cells[1][quadrant];
+    }
+
+    _stream_edits(tx, _stream_origin.y(), tx, _stream_origin.y() + STREAM_SIZE - 1);
+}
+
+#ifdef WORLD_MAP_STREAM_CHECK
+// Expected cell of every ring tile: its room data, or the last edit of it
+bool WorldMap::stream_matches_room() const
+{
+    if(!_map->streamed() || !_stream_valid || !_layer_maps[0] || !_layer_maps[1])
+    {
+        return true;
+    }
+
+    for(int layer = 0; layer < 2; ++layer)
+    {
+        // A copy of the map handle, as its VRAM view isn't const
+        bn::regular_bg_map_ptr map = *_layer_maps[layer];
+        const bn::regular_bg_map_cell* cells = map.vram()->data();
+
+        for(int ty = _stream_origin.y(); ty < _stream_origin.y() + STREAM_SIZE; ++ty)
+        {
+            for(int tx = _stream_origin.x(); tx < _stream_origin.x() + STREAM_SIZE; ++tx)
+            {
+                const int quadrant = (ty % METATILE_SIZE) * METATILE_SIZE + tx % METATILE_SIZE;
+                int expected = _map->metatile_at(tx, ty).cells[layer][quadrant];
+
+                // The last edit of a cell wins
+                for(const TileEdit& edit : _edits)
+                {
+                    if(edit.room == _current_room && edit.layer == layer && edit.tx == tx && edit.ty == ty)
+                    {
+                        expected = edit.value;
+                    }
+                }
+
+                if(cells[(ty % STREAM_SIZE) * STREAM_SIZE + tx % STREAM_SIZE] != expected)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+#endif
+
+// Write the cell edits of tiles [tx0, tx1] x [ty0, ty1] held by the ring over
+// the cells expanded from ROM
+void WorldMap::_stream_edits(int tx0, int ty0, int tx1, int ty1)
+{
+    if(!_stream_valid)
+    {
+        return;
+    }
+
+    tx0 = bn::max(tx0, _stream_origin.x());
+    ty0 = bn::max(ty0, _stream_origin.y());
+    tx1 = bn::min(tx1, _stream_origin.x() + STREAM_SIZE - 1);
+    ty1 = bn::min(ty1, _stream_origin.y() + STREAM_SIZE - 1);
+
+    for(const TileEdit& edit : _edits)
+    {
+        if(edit.room == _current_room && edit.layer != attributes_edit_layer &&
+           edit.tx >= tx0 && edit.tx <= tx1 && edit.ty >= ty0 && edit.ty <= ty1)
+        {
+            const int cell = (edit.ty % STREAM_SIZE) * STREAM_SIZE + edit.tx % STREAM_SIZE;
+            _layer_maps[edit.layer]->vram()->data()[cell] = edit.value;
+        }
     }
 }
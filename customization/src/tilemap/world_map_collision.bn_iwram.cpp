@@ -0,0 +1,6 @@
+#include "hot_code.h"
+
+// ARM code in IWRAM when HOTCODE has this set (see world_map_collision.cpp)
+#if HOT_CODE_COLLISION
+    #include "world_map_collision.inc"
+#endif
@@ -0,0 +1,6 @@
+#include "hot_code.h"
+
+// Thumb code in ROM, unless HOTCODE has this set (see world_map_collision.bn_iwram.cpp)
+#if !HOT_CODE_COLLISION
+    #include "world_map_collision.inc"
+#endif
@@ -1,8 +1,21 @@
 #include "damage_numbers.h"
 
+#include "fixed_math.h"
+
 bn::sprite_text_generator* DamageNumbers::_text_gen = nullptr;
 bn::camera_ptr* DamageNumbers::_camera = nullptr;
 bn::vector<DamageNumbers::Entry, 16> DamageNumbers::_entries;
+int DamageNumbers::_spawn_count = 0;
+
+namespace
+{
+    constexpr bn::fixed k_rise_speed = 0.4;
+
+    // Angles from straight up of successive popups, so numbers spawned
+    // together fan out instead of stacking
+    constexpr int k_fan_angles[] = { 0, -fixed_math::k_turn / 24, fixed_math::k_turn / 24 };
+    constexpr int k_fan_angle_count = sizeof(k_fan_angles) / sizeof(k_fan_angles[0]);
+}
 
 void DamageNumbers::initialize(bn::sprite_text_generator* gen, bn::camera_ptr* camera)
 {
@@ -24,7 +37,10 @@ void DamageNumbers::spawn(const bn::fixed_point& pos, int amount)
 
     Entry e;
     e.pos      = pos;
-    e.velocity = bn::fixed_point(0, -0.4);
+    const int angle = fixed_math::k_turn * 3 / 4 + k_fan_angles[_spawn_count % k_fan_angle_count];
+    const bn::fixed_point direction = fixed_math::unit_vector(angle);
+    e.velocity = bn::fixed_point(direction.x() * k_rise_speed, direction.y() * k_rise_speed);
+    ++_spawn_count;
     e.lifetime = 30;
 
     bn::string<8> text;
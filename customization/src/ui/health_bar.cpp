@@ -9,6 +9,9 @@ void HealthBar::attach_camera(const bn::camera_ptr& camera) {
         _sprite->set_camera(camera);
     }
     _camera = camera;
+
+    // Take the sprite now, so spawning counts it (see EnemyPool)
+    _ensure_created();
 }
 
 void HealthBar::_ensure_created()
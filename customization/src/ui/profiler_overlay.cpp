@@ -0,0 +1,212 @@
+#include "profiler_overlay.h"
+
+#include "bn_log.h"
+#include "bn_sprites.h"
+#include "bn_string.h"
+
+#include "game_input.h"
+
+namespace
+{
+    constexpr int k_left_x     = -116;
+    constexpr int k_top_y      = -74;
+    constexpr int k_line_height = 9;
+    constexpr int k_chars_per_sprite = 4;    // 8x8 font, 32x8 text sprites
+
+    bool toggle_pressed()
+    {
+        using key_type = bn::keypad::key_type;
+
+        return GameInput::held(key_type::L) && GameInput::held(key_type::R) &&
+               GameInput::pressed(key_type::SELECT);
+    }
+
+    void append_ticks(bn::string<48>& text, int ticks)
+    {
+        text += ' ';
+        text += bn::to_string<8>(ticks);
+    }
+
+    void append_percent(bn::string<48>& text, int ticks)
+    {
+        text += ' ';
+        text += bn::to_string<8>(int(int64_t(ticks) * 100 / ProfilerOverlay::frame_ticks));
+        text += '%';
+    }
+}
+
+void ProfilerOverlay::Stats::add(int ticks)
+{
+    min = ticks < min ? ticks : min;
+    max = ticks > max ? ticks : max;
+    sum += ticks;
+}
+
+void ProfilerOverlay::Stats::close_window()
+{
+    shown_min = min;
+    shown_average = int(sum / window_frames);
+    shown_max = max;
+
+    min = INT32_MAX;
+    max = 0;
+    sum = 0;
+}
+
+ProfilerOverlay::ProfilerOverlay(bn::sprite_text_generator& text_generator) :
+    _text_generator(text_generator)
+{
+}
+
+int ProfilerOverlay::add_scope(const char* name)
+{
+    BN_ASSERT(!_scopes.full(), "Too many profiler scopes: ", name);
+
+    _scopes.push_back(Scope{ name, 0, Stats() });
+    return _scopes.size() - 1;
+}
+
+void ProfilerOverlay::record(int scope, int ticks)
+{
+    _scopes[scope].ticks = ticks;
+}
+
+void ProfilerOverlay::update(const FrameScheduler& scheduler)
+{
+    if(toggle_pressed())
+    {
+        _visible = !_visible;
+
+        if(!_visible)
+        {
+            _sprites.clear();
+        }
+    }
+
+    for(int phase = 0; phase < FRAME_PHASE_COUNT; ++phase)
+    {
+        _phases[phase].add(scheduler.phase_ticks(static_cast<FramePhase>(phase)));
+    }
+
+    for(int id = 0; id < scheduler.system_count(); ++id)
+    {
+        _systems[id].add(scheduler.system_ticks(id));
+    }
+
+    for(Scope& scope : _scopes)
+    {
+        scope.stats.add(scope.ticks);
+        scope.ticks = 0;
+    }
+
+    _frame.add(scheduler.frame_ticks());
+
+    if(++_window_frame == window_frames)
+    {
+        _window_frame = 0;
+        _close_window(scheduler);
+    }
+}
+
+void ProfilerOverlay::_close_window(const FrameScheduler& scheduler)
+{
+    for(Stats& stats : _phases)
+    {
+        stats.close_window();
+    }
+
+    for(int id = 0; id < scheduler.system_count(); ++id)
+    {
+        _systems[id].close_window();
+    }
+
+    for(Scope& scope : _scopes)
+    {
+        scope.stats.close_window();
+    }
+
+    _frame.close_window();
+
+    if(_visible)
+    {
+        _log(scheduler);
+        _redraw();
+    }
+}
+
+void ProfilerOverlay::_log(const FrameScheduler& scheduler) const
+{
+    auto log_stats = [](const char* name, const Stats& stats)
+    {
+        BN_LOG("profile ", name, " min ", stats.shown_min, " avg ", stats.shown_average, " max ", stats.shown_max,
+               " frame% ", int(int64_t(stats.shown_average) * 100 / frame_ticks));
+    };
+
+    for(int id = 0; id < scheduler.system_count(); ++id)
+    {
+        log_stats(scheduler.system_name(id), _systems[id]);
+    }
+
+    for(const Scope& scope : _scopes)
+    {
+        log_stats(scope.name, scope.stats);
+    }
+
+    log_stats("logic", _frame);
+}
+
+void ProfilerOverlay::_redraw()
+{
+    _sprites.clear();
+    _text_generator.set_left_alignment();
+
+    int y = k_top_y;
+
+    auto draw_line = [this, &y](const char* name, const Stats& stats)
+    {
+        bn::string<48> text = name;
+        append_ticks(text, stats.shown_min);
+        append_ticks(text, stats.shown_average);
+        append_ticks(text, stats.shown_max);
+        append_percent(text, stats.shown_average);
+
+        _draw_text(y, text);
+        y += k_line_height;
+    };
+
+    _draw_text(y, "ticks min avg max");
+    y += k_line_height;
+
+    for(int phase = 0; phase < FRAME_PHASE_COUNT; ++phase)
+    {
+        draw_line(frame_phase_name(static_cast<FramePhase>(phase)), _phases[phase]);
+    }
+
+    for(const Scope& scope : _scopes)
+    {
+        draw_line(scope.name, scope.stats);
+    }
+
+    draw_line("logic", _frame);
+
+    for(bn::sprite_ptr& sprite : _sprites)
+    {
+        sprite.set_bg_priority(0);
+        sprite.set_z_order(-32767);
+    }
+}
+
+// The overlay can be shown in any build, while the enemy pool leaves only a
+// few sprites for the UI: a line is left out when the sprites left (or the
+// room in _sprites) can't hold it
+void ProfilerOverlay::_draw_text(int y, const bn::string<48>& text)
+{
+    const int sprites = (text.size() + k_chars_per_sprite - 1) / k_chars_per_sprite;
+
+    if(sprites > bn::sprites::available_items_count() || sprites > _sprites.available())
+    {
+        return;
+    }
+
+    _text_generator.generate(k_left_x, y, text, _sprites);
+}
@@ -0,0 +1,175 @@
+"""
+bench_runner.py
+Runs benchmark ROMs under a headless emulator and writes their results as
+JSON. make bench runs one ROM per scenario:
+
+- chase, doors, menu: this project's scenarios (see include/core/benchmark.h)
+- upgrades: the upgrade graph fill of ../upgrade (see upgrade_bench.h there)
+
+Every ROM logs "bench ..." lines through the mGBA debug log once its scenario
+ran. The emulator is stopped after the "bench end" line (or after --timeout
+seconds), and the lines are turned into one JSON object per scenario:
+
+    {"commit": "...", "frame_ticks": 4389, "scenarios": {"chase": {
+        "frames": 1800, "frames_over_budget": 0, "average_ticks": ...,
+        "max_ticks": ..., "phases": {"ai": {"frames": ..., "average_ticks":
+        ..., "max_ticks": ...}, ...}}, ...}}
+
+Times are bn::timer ticks (64 CPU cycles each).
+
+With --baseline, the results are compared with a previous results file (e.g.
+one written on another commit) and the differences are printed.
+
+Usage: bench_runner.py --emulator="mgba-rom-test -l 31" --output=results.json
+                       [--baseline=old.json] [--timeout=120] rom.gba [rom.gba ...]
+"""
+
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+import threading
+
+# Must match Benchmark::frame_ticks: bn::timers::ticks_per_frame(), 280896 cycles / 64
+FRAME_TICKS = 280896 // 64
+
+
+def parse_line(line, result):
+    """Adds one "bench ..." log line to result, returns True on the end line."""
+    index = line.find('bench ')
+
+    if index < 0:
+        return False
+
+    words = line[index:].split()
+
+    if len(words) < 2:
+        return False
+
+    kind = words[1]
+
+    if kind == 'begin' and len(words) >= 4:
+        result['scenario'] = words[2]
+    elif kind == 'frames' and len(words) >= 9:
+        result['frames'] = int(words[2])
+        result['frames_over_budget'] = int(words[4])
+        result['average_ticks'] = int(words[6])
+        result['max_ticks'] = int(words[8])
+    elif kind == 'phase' and len(words) >= 9:
+        result['phases'][words[2]] = {
+            'frames': int(words[4]),
+            'average_ticks': int(words[6]),
+            'max_ticks': int(words[8]),
+        }
+    elif kind == 'end':
+        return True
+
+    return False
+
+
+def run_rom(emulator, rom, timeout):
+    command = shlex.split(emulator) + [rom]
+    process = subprocess.Popen(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True,
+                               errors='replace')
+    result = {'phases': {}}
+    finished = False
+
+    # Stops an emulator that hangs or doesn't print anything
+    watchdog = threading.Timer(timeout, process.kill)
+    watchdog.start()
+
+    try:
+        for line in process.stdout:
+            if parse_line(line, result):
+                finished = True
+                break
+    finally:
+        watchdog.cancel()
+        process.kill()
+        process.wait()
+
+    if not finished:
+        raise RuntimeError(rom + ': no benchmark results (is the emulator printing the debug log?)')
+
+    result['phases'] = result.pop('phases')     # after the frame totals
+    return result
+
+
+def git_commit():
+    try:
+        output = subprocess.run(['git', 'rev-parse', '--short', 'HEAD'], capture_output=True, text=True, check=True)
+        return output.stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def percent(value, baseline):
+    if not baseline:
+        return ''
+
+    return ' (%+.1f%%)' % ((value - baseline) * 100.0 / baseline)
+
+
+def print_results(results, baseline):
+    base_scenarios = baseline['scenarios'] if baseline else {}
+
+    for name, scenario in results['scenarios'].items():
+        base = base_scenarios.get(name, {})
+        base_phases = base.get('phases', {})
+
+        print('%s: %d frames, %d over budget%s' % (
+            name, scenario['frames'], scenario['frames_over_budget'],
+            ' (was %d)' % base['frames_over_budget'] if 'frames_over_budget' in base else ''))
+        print('    %-12s %10d avg %10d max%s' % (
+            'frame', scenario['average_ticks'], scenario['max_ticks'],
+            percent(scenario['average_ticks'], base.get('average_ticks'))))
+
+        for phase_name, phase in scenario['phases'].items():
+            base_phase = base_phases.get(phase_name, {})
+            print('    %-12s %10d avg %10d max%s' % (
+                phase_name, phase['average_ticks'], phase['max_ticks'],
+                percent(phase['average_ticks'], base_phase.get('average_ticks'))))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Benchmark ROM runner.')
+    parser.add_argument('--emulator', required=True, help='headless emulator command printing the mGBA debug log')
+    parser.add_argument('--output', required=True, help='results JSON file path')
+    parser.add_argument('--baseline', help='previous results JSON file path to compare with')
+    parser.add_argument('--timeout', type=float, default=120, help='seconds before a ROM is stopped')
+    parser.add_argument('roms', nargs='+', help='benchmark ROM paths')
+    args = parser.parse_args()
+
+    baseline = None
+
+    if args.baseline:
+        with open(args.baseline) as file:
+            baseline = json.load(file)
+
+    results = {'commit': git_commit(), 'frame_ticks': FRAME_TICKS, 'scenarios': {}}
+
+    for rom in args.roms:
+        result = run_rom(args.emulator, rom, args.timeout)
+        results['scenarios'][result.pop('scenario', os.path.basename(rom))] = result
+
+    output_folder = os.path.dirname(args.output)
+
+    if output_folder and not os.path.isdir(output_folder):
+        os.makedirs(output_folder)
+
+    with open(args.output, 'w') as file:
+        json.dump(results, file, indent=4)
+        file.write('\n')
+
+    print_results(results, baseline)
+    print('Results written to ' + args.output)
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except Exception as exc:
+        sys.stderr.write('bench_runner error: ' + str(exc) + '\n')
+        sys.exit(-1)
@@ -0,0 +1,311 @@
+"""
+character_sheets.py
+Converts the 8bpp character component sheets into 4bpp sheets for the game.
+
+The sheets share one 32-color layout (see character_colors.cpp): indices 1-15
+are the color ramps replaced at runtime by the character appearance, the
+other ones are fixed colors (outlines, highlights, ...). A sheet only uses a
+few of them, so sheets are packed into 16-color palette banks: each bank lists
+the 8bpp indices used by its sheets (index 0 stays transparent), and the
+pixels of a sheet are rewritten as bank slots. Sheets are packed in name
+order into the first bank with room for their colors. A sheet with more than
+15 colors has its least used fixed colors merged into the closest remaining
+fixed color. As that changes the art, a merge fails the build unless it is
+allowed with --allow-merge=<sheet>:<color> (the 8bpp index merged away), and
+allowed merges which don't happen anymore fail it too, so the list is kept
+exact.
+
+Written to the build folder:
+- graphics/<sheet>.bmp and .json: the 4bpp sheet, with its bank colors
+- graphics/character_palette.bmp and .json: the 32-color 8bpp layout, for
+  sprites drawn from several banks at once (composited characters)
+- generated_character_sheets.h: the bank of every sheet and the 8bpp index
+  of every bank slot
+
+Usage: character_sheets.py --sheets=graphics/character_customization/components --build=build
+                           [--allow-merge=base_0:24 ...]
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+LAYOUT_COLORS = 32      # 8bpp layout of the source sheets
+RAMP_COLORS = 16        # indices 1-15 are replaced by the appearance ramps
+BANK_COLORS = 16
+
+
+def read_bmp(file_path):
+    with open(file_path, 'rb') as file:
+        data = file.read()
+
+    if data[0:2] != b'BM':
+        raise ValueError(file_path + ': not a BMP file')
+
+    pixels_offset, header_size = struct.unpack('<II', data[10:18])
+    width, height = struct.unpack('<ii', data[18:26])
+    bpp, compression = struct.unpack('<HI', data[28:34])
+
+    if bpp != 8 or compression != 0:
+        raise ValueError(file_path + ': only uncompressed 8bpp BMP files are supported')
+
+    colors_offset = 14 + header_size
+    colors = []
+
+    for index in range(LAYOUT_COLORS):
+        blue, green, red = data[colors_offset + index * 4:colors_offset + index * 4 + 3]
+        colors.append((red, green, blue))
+
+    row_size = (width + 3) // 4 * 4
+    rows = []
+
+    for row in range(abs(height)):
+        start = pixels_offset + row * row_size
+        rows.append(data[start:start + width])
+
+    if height > 0:
+        rows.reverse()      # bottom-up
+
+    return width, abs(height), colors, rows
+
+
+def write_bmp(file_path, width, height, bpp, colors, rows):
+    """Writes a bottom-up BMP; rows hold one palette index per pixel."""
+    row_size = (width * bpp // 8 + 3) // 4 * 4
+    colors_size = len(colors) * 4
+    pixels_offset = 14 + 40 + colors_size
+    pixels = bytearray()
+
+    for row in reversed(rows):
+        if bpp == 4:
+            packed = bytearray((row[x] << 4) | row[x + 1] for x in range(0, width, 2))
+        else:
+            packed = bytearray(row)
+
+        pixels += packed + bytes(row_size - len(packed))
+
+    data = bytearray(b'BM')
+    data += struct.pack('<IHHI', pixels_offset + len(pixels), 0, 0, pixels_offset)
+    data += struct.pack('<IiiHHIIiiII', 40, width, height, 1, bpp, 0, len(pixels), 2835, 2835, len(colors), 0)
+
+    for red, green, blue in colors:
+        data += bytes((blue, green, red, 0))
+
+    data += pixels
+    write_if_changed(file_path, bytes(data))
+
+
+def write_if_changed(file_path, data):
+    mode = 'b' if isinstance(data, bytes) else ''
+
+    if os.path.isfile(file_path):
+        with open(file_path, 'r' + mode) as file:
+            if file.read() == data:
+                return False
+
+    with open(file_path, 'w' + mode) as file:
+        file.write(data)
+
+    return True
+
+
+def color_distance(a, b):
+    return sum((a[channel] - b[channel]) ** 2 for channel in range(3))
+
+
+def used_indices(rows):
+    counts = {}
+
+    for row in rows:
+        for index in row:
+            counts[index] = counts.get(index, 0) + 1
+
+    counts.pop(0, None)
+    return counts
+
+
+def merge_colors(name, counts, colors, report, merges):
+    """Returns old index -> kept index, so that at most BANK_COLORS - 1 remain.
+
+    Every merge is added to merges as "<sheet>:<merged index>"."""
+    remap = {index: index for index in counts}
+    kept = dict(counts)
+
+    while len(kept) > BANK_COLORS - 1:
+        fixed = [index for index in kept if index >= RAMP_COLORS]
+
+        if len(fixed) < 2:
+            raise ValueError(name + ': too many ramp colors for a 16-color bank')
+
+        merged = min(fixed, key=lambda index: (kept[index], index))
+        target = min((index for index in fixed if index != merged),
+                     key=lambda index: (color_distance(colors[merged], colors[index]), index))
+        report.append('    ' + name + ': color ' + str(merged) + ' ' + str(colors[merged]) + ' (' +
+                      str(kept[merged]) + ' pixels) merged into color ' + str(target) + ' ' + str(colors[target]))
+        merges.append(name + ':' + str(merged))
+
+        kept[target] += kept.pop(merged)
+
+        for index, kept_index in remap.items():
+            if kept_index == merged:
+                remap[index] = target
+
+    return remap
+
+
+def generate_header(sheets, banks):
+    lines = [
+        '// Generated by tools/character_sheets.py. Do not edit.',
+        '',
+        '#ifndef GENERATED_CHARACTER_SHEETS_H',
+        '#define GENERATED_CHARACTER_SHEETS_H',
+        '',
+        '#include <stdint.h>',
+        '',
+        '#include "bn_sprite_item.h"',
+        '',
+    ]
+
+    for sheet in sheets:
+        lines.append('#include "bn_sprite_items_' + sheet['name'] + '.h"')
+
+    lines += [
+        '',
+        '// 16-color palette banks shared by the 4bpp character sheets',
+        'constexpr int k_character_palette_banks = ' + str(len(banks)) + ';',
+        '',
+        '// 8bpp character palette index of every bank slot (0: transparent or unused)',
+        'inline constexpr uint8_t k_character_bank_colors[k_character_palette_banks][' + str(BANK_COLORS) + '] =',
+        '{',
+    ]
+
+    for bank in banks:
+        slots = [0] + bank + [0] * (BANK_COLORS - 1 - len(bank))
+        lines.append('    { ' + ', '.join(str(index) for index in slots) + ' },')
+
+    lines += [
+        '};',
+        '',
+        'struct CharacterSheet',
+        '{',
+        '    const bn::sprite_item* item;',
+        '    int bank;',
+        '};',
+        '',
+        'inline constexpr CharacterSheet k_character_sheets[] =',
+        '{',
+    ]
+
+    for sheet in sheets:
+        lines.append('    { &bn::sprite_items::' + sheet['name'] + ', ' + str(sheet['bank']) + ' },')
+
+    lines += [
+        '};',
+        '',
+        '#endif',
+        '',
+    ]
+
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Character sheets 4bpp converter.')
+    parser.add_argument('--sheets', required=True, help='8bpp character sheets folder path')
+    parser.add_argument('--build', required=True, help='build folder path')
+    parser.add_argument('--allow-merge', action='append', default=[], metavar='SHEET:COLOR',
+                        help='color merge allowed in a sheet (8bpp index merged away), can be repeated')
+    args = parser.parse_args()
+
+    graphics_folder = os.path.join(args.build, 'graphics')
+    os.makedirs(graphics_folder, exist_ok=True)
+
+    sheets = []
+    banks = []
+    report = []
+    merges = []
+    layout_colors = None
+
+    for file_name in sorted(os.listdir(args.sheets)):
+        name, extension = os.path.splitext(file_name)
+
+        if extension != '.json':
+            continue
+
+        with open(os.path.join(args.sheets, file_name)) as file:
+            info = json.load(file)
+
+        if info.get('type') != 'sprite':
+            continue
+
+        width, height, colors, rows = read_bmp(os.path.join(args.sheets, name + '.bmp'))
+        layout_colors = layout_colors or colors
+        remap = merge_colors(name, used_indices(rows), colors, report, merges)
+        indices = sorted(set(remap.values()))
+
+        # First bank with room for the colors of the sheet
+        for bank_index, bank in enumerate(banks):
+            if len(set(bank) | set(indices)) <= BANK_COLORS - 1:
+                break
+        else:
+            bank_index = len(banks)
+            banks.append([])
+
+        bank = banks[bank_index]
+        bank += [index for index in indices if index not in bank]
+        sheets.append({'name': name, 'info': info, 'width': width, 'height': height, 'colors': colors,
+                       'rows': rows, 'remap': remap, 'bank': bank_index})
+
+    unexpected = [merge for merge in merges if merge not in args.allow_merge]
+    stale = [merge for merge in args.allow_merge if merge not in merges]
+
+    if unexpected:
+        raise ValueError('colors merged without --allow-merge (check the art, then allow them):\n' +
+                         '\n'.join(report) + '\n    not allowed: ' + ' '.join(unexpected))
+
+    if stale:
+        raise ValueError('allowed color merges which don\'t happen anymore (remove them): ' + ' '.join(stale))
+
+    # Sheets are written once every bank is complete (a bank can grow after a
+    # sheet was added to it)
+    for sheet in sheets:
+        bank = banks[sheet['bank']]
+        slots = {index: bank.index(index) + 1 for index in bank}
+        colors = sheet['colors']
+        bank_colors = [colors[0]] + [colors[index] for index in bank]
+        bank_colors += [(0, 0, 0)] * (BANK_COLORS - len(bank_colors))
+        rows = [[slots[sheet['remap'][index]] if index else 0 for index in row] for row in sheet['rows']]
+
+        write_bmp(os.path.join(graphics_folder, sheet['name'] + '.bmp'), sheet['width'], sheet['height'], 4,
+                  bank_colors, rows)
+
+        info = dict(sheet['info'])
+        info['bpp_mode'] = 'bpp_4'
+        info.pop('colors_count', None)
+        write_if_changed(os.path.join(graphics_folder, sheet['name'] + '.json'), json.dumps(info, indent=4) + '\n')
+
+    if layout_colors:
+        write_bmp(os.path.join(graphics_folder, 'character_palette.bmp'), 8, 8, 8, layout_colors, [[0] * 8] * 8)
+        write_if_changed(os.path.join(graphics_folder, 'character_palette.json'),
+                         json.dumps({'type': 'sprite_palette', 'bpp_mode': 'bpp_8',
+                                     'colors_count': LAYOUT_COLORS}, indent=4) + '\n')
+
+    if write_if_changed(os.path.join(args.build, 'generated_character_sheets.h'), generate_header(sheets, banks)):
+        print('Character sheets: ' + str(len(sheets)) + ' sheets in ' + str(len(banks)) + ' 16-color banks')
+
+        for bank_index, bank in enumerate(banks):
+            names = [sheet['name'] for sheet in sheets if sheet['bank'] == bank_index]
+            print('    bank ' + str(bank_index) + ': ' + ', '.join(names) + ' (' + str(len(bank)) + ' colors)')
+
+        for line in report:
+            print(line)
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except Exception as exc:
+        sys.stderr.write('character_sheets error: ' + str(exc) + '\n')
+        sys.exit(-1)
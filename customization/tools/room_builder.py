@@ -0,0 +1,317 @@
+"""
+room_builder.py
+Converts the room descriptions in rooms/*.json into metatile C++ arrays.
+
+Rooms are built from 2x2-tile metatiles. Every distinct block of four tiles
+(both layers plus the attributes of each tile) is stored once in a metatile
+dictionary shared by all rooms, and each room is stored as one byte per
+metatile. Metatile cells are converted at build time into
+bn::regular_bg_map_cell values, so the game only copies them into place when a
+room is loaded, and tile attributes are answered from the same byte.
+
+Tile attributes (solid, water, ...) come from the tileset attribute table in
+rooms/tile_attributes.json: a room tile gets the attributes of its layer 1 tile
+combined with the ones of its layer 2 tile. Rooms can replace the attributes
+of single tiles with "attribute_overrides": [[x, y, ["solid", ...]], ...].
+
+Regular rooms are ROOM_WIDTH x ROOM_HEIGHT tiles. Rooms of any other size are
+streamed by the game a few rows/columns at a time around the camera. The
+generated header is written to the build folder and a ROM size report is
+printed for every room.
+
+Usage: room_builder.py --rooms=rooms --build=build
+"""
+
+import argparse
+import json
+import os
+import sys
+
+# Must match world_map_data.h
+ROOM_WIDTH = 64
+ROOM_HEIGHT = 64
+STREAM_SIZE = 32
+METATILE_SIZE = 2
+MAX_METATILES = 256
+MAX_ROOM_SIZE = 0x7FFF // 4   # room-centered door spawn pixels must fit in int16_t
+
+# Must match the TILE_* attribute flags in world_map_data.h
+TILE_ATTRIBUTES = {
+    'solid': 1 << 0,
+    'one_way': 1 << 1,
+    'water': 1 << 2,
+    'slow': 1 << 3,
+    'hurt': 1 << 4,
+    'door_trigger': 1 << 5,
+}
+
+# Tile index used for cells with value 0 in the room files (transparent tile)
+EMPTY_TILE_INDEX = 40
+
+
+def to_map_cell(tile):
+    return EMPTY_TILE_INDEX if tile == 0 else tile - 1
+
+
+def read_layer(room, name, file_path, width, height):
+    rows = room.get(name)
+
+    if rows is None:
+        return [0] * (width * height)
+
+    if len(rows) != height or any(len(row) != width for row in rows):
+        raise ValueError(file_path + ': ' + name + ' must be ' + str(width) + 'x' + str(height))
+
+    cells = [value for row in rows for value in row]
+
+    for value in cells:
+        if value < 0 or value > 255:
+            raise ValueError(file_path + ': ' + name + ' has an invalid tile index: ' + str(value))
+
+    return cells
+
+
+def parse_attributes(names, file_path):
+    attributes = 0
+
+    for name in names:
+        if name not in TILE_ATTRIBUTES:
+            raise ValueError(file_path + ': invalid tile attribute: ' + str(name))
+
+        attributes |= TILE_ATTRIBUTES[name]
+
+    return attributes
+
+
+def read_tile_attributes(rooms_folder):
+    # Attributes by room file tile index (0 is the empty tile)
+    file_path = os.path.join(rooms_folder, 'tile_attributes.json')
+    table = [0] * 256
+
+    if not os.path.isfile(file_path):
+        return table
+
+    with open(file_path) as file:
+        tileset = json.load(file)
+
+    for tile, names in tileset.get('attributes', {}).items():
+        index = int(tile)
+
+        if index < 0 or index > 255:
+            raise ValueError(file_path + ': invalid tile index: ' + tile)
+
+        table[index] = parse_attributes(names, file_path)
+
+    return table
+
+
+def read_attributes(room, file_path, width, height, layer1, layer2, tile_attributes):
+    attributes = [tile_attributes[tile1] | tile_attributes[tile2] for tile1, tile2 in zip(layer1, layer2)]
+
+    for override in room.get('attribute_overrides', []):
+        if len(override) != 3:
+            raise ValueError(file_path + ': attribute overrides must be [x, y, [attributes]]')
+
+        x, y, names = override
+
+        if x < 0 or x >= width or y < 0 or y >= height:
+            raise ValueError(file_path + ': attribute override out of the room: ' + str(override))
+
+        attributes[y * width + x] = parse_attributes(names, file_path)
+
+    return attributes
+
+
+def read_rooms(rooms_folder):
+    tile_attributes = read_tile_attributes(rooms_folder)
+    rooms = []
+    room_id = 0
+
+    while True:
+        file_path = os.path.join(rooms_folder, 'room' + str(room_id) + '.json')
+
+        if not os.path.isfile(file_path):
+            break
+
+        with open(file_path) as file:
+            room = json.load(file)
+
+        width = room.get('width', ROOM_WIDTH)
+        height = room.get('height', ROOM_HEIGHT)
+
+        for size in (width, height):
+            if size < STREAM_SIZE or size > MAX_ROOM_SIZE or size % STREAM_SIZE != 0:
+                raise ValueError(file_path + ': room sizes must be multiples of ' + str(STREAM_SIZE) +
+                                 ' between ' + str(STREAM_SIZE) + ' and ' + str(MAX_ROOM_SIZE))
+
+        layer1 = read_layer(room, 'layer1', file_path, width, height)
+        layer2 = read_layer(room, 'layer2', file_path, width, height)
+
+        rooms.append({
+            'file_path': file_path,
+            'width': width,
+            'height': height,
+            'layer1': layer1,
+            'layer2': layer2,
+            'attributes': read_attributes(room, file_path, width, height, layer1, layer2, tile_attributes),
+        })
+        room_id += 1
+
+    return rooms
+
+
+def build_metatiles(rooms):
+    # Metatile key: (layer1 cells, layer2 cells, attributes), all in TL TR BL BR order
+    dictionary = []
+    indices = {}
+
+    for room in rooms:
+        width = room['width']
+        grid = []
+
+        for y in range(0, room['height'], METATILE_SIZE):
+            for x in range(0, width, METATILE_SIZE):
+                positions = [(y + dy) * width + x + dx for dy in range(METATILE_SIZE) for dx in range(METATILE_SIZE)]
+                layer1 = tuple(to_map_cell(room['layer1'][position]) for position in positions)
+                layer2 = tuple(to_map_cell(room['layer2'][position]) for position in positions)
+                attributes = tuple(room['attributes'][position] for position in positions)
+                key = (layer1, layer2, attributes)
+                index = indices.get(key)
+
+                if index is None:
+                    index = len(dictionary)
+
+                    if index == MAX_METATILES:
+                        raise ValueError(room['file_path'] + ': more than ' + str(MAX_METATILES) +
+                                         ' different metatiles in the rooms folder')
+
+                    indices[key] = index
+                    dictionary.append(key)
+
+                grid.append(index)
+
+        room['metatiles'] = grid
+
+    return dictionary
+
+
+def format_bytes(name, data):
+    lines = ['constexpr uint8_t ' + name + '[] = {']
+
+    for start in range(0, len(data), 32):
+        lines.append('    ' + ', '.join(str(value) for value in data[start:start + 32]) + ',')
+
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def format_metatiles(name, dictionary):
+    lines = ['constexpr Metatile ' + name + '[] = {']
+
+    for layer1, layer2, attributes in dictionary:
+        lines.append('    { { { ' + ', '.join(str(cell) for cell in layer1) + ' }, { ' +
+                     ', '.join(str(cell) for cell in layer2) + ' } }, { ' +
+                     ', '.join('0x%02X' % value for value in attributes) + ' } },')
+
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def generate_header(rooms):
+    dictionary = build_metatiles(rooms)
+
+    lines = [
+        '// Generated by tools/room_builder.py from the rooms folder. Do not edit.',
+        '',
+        '#ifndef GENERATED_ROOMS_H',
+        '#define GENERATED_ROOMS_H',
+        '',
+        '#include "world_map_data.h"',
+        '',
+        'namespace generated_rooms',
+        '{',
+        'constexpr int room_count = ' + str(len(rooms)) + ';',
+        '',
+        format_metatiles('metatiles', dictionary),
+        '',
+    ]
+
+    report = []
+
+    for room_id, room in enumerate(rooms):
+        prefix = 'room' + str(room_id)
+        lines.append(format_bytes(prefix + '_metatiles', room['metatiles']))
+        lines.append('')
+        lines.append('constexpr RoomMapData ' + prefix + '_map = { ' + str(room['width']) + ', ' +
+                     str(room['height']) + ', metatiles, ' + prefix + '_metatiles };')
+        lines.append('')
+        report.append((room_id, room['width'], room['height'], len(room['metatiles'])))
+
+    lines += [
+        '}',
+        '',
+        '#endif // GENERATED_ROOMS_H',
+        '',
+    ]
+
+    return '\n'.join(lines), report, len(dictionary)
+
+
+def print_report(report, metatile_count):
+    raw_total = 0
+    packed_total = 0
+
+    print('room_builder: ROM usage per room (bytes)')
+    print('  room   size      metatiles   raw')
+
+    for room_id, width, height, size in report:
+        # Raw: two layers of 16-bit cells plus one byte of attributes per tile
+        raw = width * height * (2 * 2 + 1)
+        raw_total += raw
+        packed_total += size
+        print('  %4d   %3dx%-3d   %9d  %6d' % (room_id, width, height, size, raw))
+
+    # Each dictionary entry: 8 cells + 4 attribute bytes
+    dictionary_size = metatile_count * 20
+    print('  metatile dictionary: %d entries, %d bytes' % (metatile_count, dictionary_size))
+    print('  total: %d bytes (%d bytes uncompressed)' % (packed_total + dictionary_size, raw_total))
+
+
+def write_if_changed(file_path, content):
+    if os.path.isfile(file_path):
+        with open(file_path) as file:
+            if file.read() == content:
+                return False
+
+    with open(file_path, 'w') as file:
+        file.write(content)
+
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Room data builder.')
+    parser.add_argument('--rooms', required=True, help='rooms folder path')
+    parser.add_argument('--build', required=True, help='build folder path')
+    args = parser.parse_args()
+
+    rooms = read_rooms(args.rooms)
+
+    if not rooms:
+        raise ValueError('No rooms found in ' + args.rooms)
+
+    header, report, metatile_count = generate_header(rooms)
+
+    if not os.path.isdir(args.build):
+        os.makedirs(args.build)
+
+    if write_if_changed(os.path.join(args.build, 'generated_rooms.h'), header):
+        print_report(report, metatile_count)
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except Exception as exc:
+        sys.stderr.write('room_builder error: ' + str(exc) + '\n')
+        sys.exit(-1)
@@ -0,0 +1,20 @@
+#ifndef UPGRADE_BENCH_H
+#define UPGRADE_BENCH_H
+
+// Upgrade graph fill benchmark, built with -DBENCHMARK_SCENARIO=\"upgrades\"
+// (see make bench-rom). Every frame a default graph is created and all of its
+// nodes are unlocked (cursed ones are cleansed first), like a player buying
+// every upgrade at once.
+//
+// Times are bn::timer ticks. After `frames` frames the results are logged
+// through BN_LOG as the same "bench ..." lines the customization benchmarks
+// write, so its tools/bench_runner.py turns them into JSON too.
+namespace upgrade_bench
+{
+    constexpr int frames = 1800;
+
+    // Doesn't return: the runner stops the emulator after the end line
+    [[noreturn]] void run(const char* name);
+}
+
+#endif // UPGRADE_BENCH_H
@@ -5,10 +5,18 @@
 
 #include "screen_manager.h"
 
+#if defined(BENCHMARK_SCENARIO)
+    #include "upgrade_bench.h"
+#endif
+
 int main()
 {
     bn::core::init();
 
+#if defined(BENCHMARK_SCENARIO)
+    upgrade_bench::run(BENCHMARK_SCENARIO);
+#endif
+
     // Optional: set background color
     bn::bg_palettes::set_transparent_color(bn::color(0, 0, 0));
 
@@ -0,0 +1,106 @@
+#include "upgrade_bench.h"
+
+#include "bn_assert.h"
+#include "bn_core.h"
+#include "bn_log.h"
+#include "bn_string_view.h"
+#include "bn_timer.h"
+#include "bn_timers.h"
+
+#include "upgrade_graph.h"
+
+namespace
+{
+    struct Phase
+    {
+        const char* name;
+        int frames = 0;
+        int64_t sum = 0;
+        int max = 0;
+
+        void add(int ticks)
+        {
+            ++frames;
+            sum += ticks;
+            max = ticks > max ? ticks : max;
+        }
+
+        void log() const
+        {
+            BN_LOG("bench phase ", name, " frames ", frames, " average ", int(sum / frames), " max ", max);
+        }
+    };
+
+    // Unlocks one available node, returns false once there are none left
+    bool unlock_next(UpgradeGraph& graph)
+    {
+        for(int i = 0, limit = graph.node_count(); i < limit; ++i)
+        {
+            UpgradeNode& node = graph.node(i);
+
+            if(node.available && !node.unlocked)
+            {
+                node.curse_cleared = true;
+                BN_ASSERT(graph.can_unlock(node.id), "Upgrade node can't be unlocked: ", node.id);
+
+                graph.unlock(node.id);
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+namespace upgrade_bench
+{
+    void run(const char* name)
+    {
+        BN_ASSERT(bn::string_view(name) == "upgrades", "Unknown benchmark scenario: ", name);
+
+        Phase create{ "create" };
+        Phase unlock{ "unlock" };
+        Phase work{ "work" };
+        int frames_over_budget = 0;
+        bn::timer timer;
+
+        BN_LOG("bench begin ", name, ' ', frames);
+
+        for(int frame = 0; frame < frames; ++frame)
+        {
+            timer.restart();
+
+            UpgradeGraph graph = UpgradeGraph::create_default();
+            const int create_ticks = timer.elapsed_ticks();
+
+            int unlocks = 0;
+
+            while(unlock_next(graph))
+            {
+                ++unlocks;
+            }
+
+            const int work_ticks = timer.elapsed_ticks();
+            BN_ASSERT(unlocks == graph.node_count(), "Upgrade graph not filled: ", unlocks);
+
+            create.add(create_ticks);
+            unlock.add(work_ticks - create_ticks);
+            work.add(work_ticks);
+            frames_over_budget += work_ticks > bn::timers::ticks_per_frame();
+
+            bn::core::update();
+        }
+
+        // One short line each: the mGBA debug log can't take a whole JSON object
+        BN_LOG("bench frames ", frames, " over_budget ", frames_over_budget,
+               " average ", int(work.sum / frames), " max ", work.max);
+        create.log();
+        unlock.log();
+        BN_LOG("bench end ", name);
+
+        while(true)
+        {
+            bn::core::update();
+        }
+    }
+}